@@ -0,0 +1,311 @@
+/**
+ * @file centrality.hpp
+ * @brief Betweenness (Brandes) and closeness centrality on a CSRGraph, exact or sampled
+ *
+ * Brandes' algorithm runs one single-source search per source: a BFS for unweighted
+ * graphs, a Dijkstra search for weighted ones. Each search counts the shortest paths
+ * sigma(v) from the source to every vertex. The vertices are then revisited in
+ * decreasing distance order, accumulating the dependency
+ *     delta(v) = sum over successors w of sigma(v) / sigma(w) * (1 + delta(w))
+ * where w is a successor of v if an arc v -> w lies on a shortest path. Successors are
+ * found by rescanning the out-arcs, so no predecessor lists are stored. The betweenness
+ * of v is the sum of delta(v) over all sources.
+ *
+ * Sources are distributed over worker threads. Every thread owns its search scratch and
+ * its score accumulator, and the accumulators are summed once at the end, so the
+ * threads never synchronize.
+ *
+ * The sampled mode runs from k uniformly drawn sources and scales the sums by n / k.
+ * By Hoeffding's inequality and a union bound over the vertices, every score is then
+ * within error_bound of the exact value with the requested confidence, where
+ * error_bound = n (n - 2) sqrt(ln(2n / (1 - confidence)) / (2k)) before normalization.
+ *
+ * Scores follow the usual conventions: for undirected graphs each pair counts once
+ * (the directed sum is halved), and normalization divides by the number of pairs that
+ * do not include the vertex.
+ *
+ * Time Complexity: O(S * (V + E)) unweighted, O(S * (V + E) log V) weighted, for S sources
+ *
+ * Space Complexity: O(V) per thread
+ */
+
+#ifndef CENTRALITY_HPP
+#define CENTRALITY_HPP
+
+#include <cmath>
+#include <queue>
+#include <random>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include "csr_graph.hpp"
+#include "../other/parallel_for.hpp"
+
+/**
+ * @brief Options for betweenness_centrality() and closeness_centrality()
+ */
+struct CentralityOptions {
+    size_t threads = 0;         // Worker threads (0 means default_thread_count())
+    bool weighted = true;       // Use arc weights if the graph has them; otherwise count hops
+    bool normalized = false;    // Divide betweenness by the number of pairs not including the vertex
+    size_t samples = 0;         // Betweenness only: sources to sample (0, or at least V, means every vertex)
+    double confidence = 0.95;   // Probability that every sampled score is within error_bound
+    uint64_t seed = 1;          // Seed for drawing the sampled sources
+};
+
+/**
+ * @brief Scores produced by betweenness_centrality() and closeness_centrality()
+ */
+struct CentralityResult {
+    std::vector<double> score;
+    size_t sources = 0;         // Single-source searches run
+    bool exact = true;
+    double error_bound = 0.0;   // Sampled betweenness: bound on |score - exact| holding for all vertices at once
+};
+
+namespace centrality_detail {
+
+inline constexpr int64_t UNREACHED = -1;
+
+// Working memory for the searches of one thread. order lists the vertices reached by
+// the last search in non-decreasing distance; only they are reset before the next one.
+struct Scratch {
+    std::vector<int64_t> distance;
+    std::vector<double> sigma;
+    std::vector<double> delta;
+    std::vector<uint32_t> order;
+    std::priority_queue<std::pair<int64_t, uint32_t>, std::vector<std::pair<int64_t, uint32_t>>,
+                        std::greater<>> heap;
+
+    explicit Scratch(size_t n) : distance(n, UNREACHED), sigma(n, 0.0), delta(n, 0.0) {
+        order.reserve(n);
+    }
+
+    void reset() {
+        for (uint32_t v : order) {
+            distance[v] = UNREACHED;
+            sigma[v] = 0.0;
+            delta[v] = 0.0;
+        }
+        order.clear();
+    }
+};
+
+inline bool use_weights(const CSRGraph& graph, const CentralityOptions& options) {
+    return options.weighted && graph.is_weighted();
+}
+
+inline void check_weights(const CSRGraph& graph, const CentralityOptions& options) {
+    if (use_weights(graph, options)) {
+        for (int weight : graph.weights()) {
+            if (weight <= 0) {
+                throw std::invalid_argument("Centrality requires positive weights");
+            }
+        }
+    }
+}
+
+// Single-source search filling distance, sigma and order (settle order)
+inline void search(const CSRGraph& graph, uint32_t source, bool weighted, Scratch& scratch) {
+    scratch.reset();
+    scratch.distance[source] = 0;
+    scratch.sigma[source] = 1.0;
+    if (!weighted) {
+        scratch.order.push_back(source);
+        for (size_t head = 0; head < scratch.order.size(); ++head) {
+            uint32_t v = scratch.order[head];
+            for (uint32_t w : graph.neighbors(v)) {
+                if (scratch.distance[w] == UNREACHED) {
+                    scratch.distance[w] = scratch.distance[v] + 1;
+                    scratch.order.push_back(w);
+                }
+                if (scratch.distance[w] == scratch.distance[v] + 1) {
+                    scratch.sigma[w] += scratch.sigma[v];
+                }
+            }
+        }
+        return;
+    }
+
+    // Vertices enter order when settled; sigma(v) is final by then because every
+    // predecessor is strictly closer and was settled earlier
+    auto& heap = scratch.heap;
+    heap.emplace(0, source);
+    std::vector<uint32_t>& settled = scratch.order;
+    while (!heap.empty()) {
+        auto [d, v] = heap.top();
+        heap.pop();
+        if (d != scratch.distance[v] || scratch.delta[v] != 0.0) {
+            continue;
+        }
+        scratch.delta[v] = 1.0;    // Settled mark; cleared again before the accumulation
+        settled.push_back(v);
+        auto neighbors = graph.neighbors(v);
+        auto weights = graph.neighbor_weights(v);
+        for (size_t i = 0; i < neighbors.size(); ++i) {
+            uint32_t w = neighbors[i];
+            int64_t candidate = d + weights[i];
+            if (scratch.distance[w] == UNREACHED || candidate < scratch.distance[w]) {
+                scratch.distance[w] = candidate;
+                scratch.sigma[w] = scratch.sigma[v];
+                heap.emplace(candidate, w);
+            } else if (candidate == scratch.distance[w]) {
+                scratch.sigma[w] += scratch.sigma[v];
+            }
+        }
+    }
+    // Vertices pushed but superseded are all settled later, so order holds every reached vertex
+    for (uint32_t v : settled) {
+        scratch.delta[v] = 0.0;
+    }
+}
+
+// Brandes' dependency accumulation for the last search; adds delta to score
+inline void accumulate(const CSRGraph& graph, uint32_t source, bool weighted, Scratch& scratch,
+                       std::vector<double>& score) {
+    for (auto it = scratch.order.rbegin(); it != scratch.order.rend(); ++it) {
+        uint32_t v = *it;
+        auto neighbors = graph.neighbors(v);
+        auto weights = graph.neighbor_weights(v);
+        double sum = 0.0;
+        for (size_t i = 0; i < neighbors.size(); ++i) {
+            uint32_t w = neighbors[i];
+            int64_t step = weighted ? weights[i] : 1;
+            if (scratch.distance[w] == scratch.distance[v] + step) {
+                sum += (1.0 + scratch.delta[w]) / scratch.sigma[w];
+            }
+        }
+        scratch.delta[v] = scratch.sigma[v] * sum;
+        if (v != source) {
+            score[v] += scratch.delta[v];
+        }
+    }
+}
+
+// Run body(source, scratch, accumulator) for every source across threads and sum the accumulators
+template<typename Body>
+std::vector<double> for_each_source(const CSRGraph& graph, const std::vector<uint32_t>& sources, size_t threads,
+                                    Body body) {
+    size_t n = graph.vertex_count();
+    threads = std::max<size_t>(1, std::min(threads == 0 ? default_thread_count() : threads, sources.size()));
+    std::vector<Scratch> scratch;
+    std::vector<std::vector<double>> partial(threads, std::vector<double>(n, 0.0));
+    scratch.reserve(threads);
+    for (size_t t = 0; t < threads; ++t) {
+        scratch.emplace_back(n);
+    }
+    parallel_for_blocks(0, sources.size(), 1, [&](size_t lo, size_t hi, size_t worker) {
+        for (size_t i = lo; i < hi; ++i) {
+            body(sources[i], scratch[worker], partial[worker]);
+        }
+    }, threads);
+
+    std::vector<double> total = std::move(partial[0]);
+    parallel_for(0, n, [&](size_t v) {
+        for (size_t t = 1; t < threads; ++t) {
+            total[v] += partial[t][v];
+        }
+    }, 4096, threads);
+    return total;
+}
+
+} // namespace centrality_detail
+
+/**
+ * @brief Compute the betweenness centrality of every vertex (Brandes' algorithm)
+ * @param graph The graph (directed or undirected)
+ * @param options Threads, weighting, normalization and sampling
+ * @return The scores; for a sampled run, also the error bound
+ * @throw std::invalid_argument if a weight used is not positive, or confidence is not in (0, 1)
+ */
+inline CentralityResult betweenness_centrality(const CSRGraph& graph, const CentralityOptions& options = {}) {
+    using namespace centrality_detail;
+    check_weights(graph, options);
+    if (!(options.confidence > 0.0 && options.confidence < 1.0)) {
+        throw std::invalid_argument("Confidence must be in (0, 1)");
+    }
+    size_t n = graph.vertex_count();
+    bool weighted = use_weights(graph, options);
+
+    CentralityResult result;
+    std::vector<uint32_t> sources(n);
+    std::iota(sources.begin(), sources.end(), 0);
+    if (options.samples > 0 && options.samples < n) {
+        std::mt19937_64 rng(options.seed);
+        std::shuffle(sources.begin(), sources.end(), rng);
+        sources.resize(options.samples);
+        result.exact = false;
+    }
+    result.sources = sources.size();
+
+    result.score = for_each_source(graph, sources, options.threads,
+                                   [&](uint32_t source, Scratch& scratch, std::vector<double>& score) {
+        search(graph, source, weighted, scratch);
+        accumulate(graph, source, weighted, scratch, score);
+    });
+
+    double scale = result.exact ? 1.0 : static_cast<double>(n) / static_cast<double>(sources.size());
+    if (!graph.is_directed()) {
+        scale /= 2.0;
+    }
+    if (options.normalized && n > 2) {
+        double pairs = static_cast<double>(n - 1) * static_cast<double>(n - 2);
+        scale /= graph.is_directed() ? pairs : pairs / 2.0;
+    }
+    for (double& value : result.score) {
+        value *= scale;
+    }
+    if (!result.exact) {
+        // Per-source dependencies lie in [0, n - 2]; the sum over sampled sources is scaled by n / k
+        double k = static_cast<double>(sources.size());
+        double epsilon = std::sqrt(std::log(2.0 * static_cast<double>(n) / (1.0 - options.confidence)) / (2.0 * k));
+        result.error_bound = epsilon * static_cast<double>(n - 2) * k * scale;
+    }
+    return result;
+}
+
+/**
+ * @brief Compute the closeness centrality of every vertex
+ *
+ * Uses the Wasserman-Faust form, which stays meaningful on disconnected graphs: for a
+ * vertex that reaches r - 1 other vertices at total distance D, the score is
+ * (r - 1) / D * (r - 1) / (n - 1), and 0 if it reaches nothing. Distances are measured
+ * from the vertex along out-arcs.
+ *
+ * @param graph The graph (directed or undirected)
+ * @param options Threads and weighting (sampling and normalization do not apply)
+ * @return The scores
+ * @throw std::invalid_argument if a weight used is not positive
+ */
+inline CentralityResult closeness_centrality(const CSRGraph& graph, const CentralityOptions& options = {}) {
+    using namespace centrality_detail;
+    check_weights(graph, options);
+    size_t n = graph.vertex_count();
+    bool weighted = use_weights(graph, options);
+
+    std::vector<uint32_t> sources(n);
+    std::iota(sources.begin(), sources.end(), 0);
+    CentralityResult result;
+    result.sources = n;
+    result.score = for_each_source(graph, sources, options.threads,
+                                   [&](uint32_t source, Scratch& scratch, std::vector<double>& score) {
+        search(graph, source, weighted, scratch);
+        double total = 0.0;
+        for (uint32_t v : scratch.order) {
+            total += static_cast<double>(scratch.distance[v]);
+        }
+        double reached = static_cast<double>(scratch.order.size() - 1);
+        if (total > 0.0) {
+            score[source] = reached / total * reached / static_cast<double>(n - 1);
+        }
+    });
+    return result;
+}
+
+#endif // CENTRALITY_HPP
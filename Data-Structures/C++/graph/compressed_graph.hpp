@@ -0,0 +1,389 @@
+/**
+ * @file compressed_graph.hpp
+ * @brief Byte-compressed adjacency lists (gap + varint encoding) with traversal and PageRank
+ *
+ * In the style of Ligra+ and WebGraph, every neighbor list is stored as a byte stream:
+ * - the first neighbor, as a zigzag-encoded signed gap from the vertex itself
+ * - every further neighbor, as the gap to its predecessor minus one
+ * - after each neighbor of a weighted graph, its weight as a zigzag varint
+ * Varints are LEB128: 7 payload bits per byte, high bit set on all but the last byte.
+ * Sorted lists of nearby IDs (see reordering.hpp) mostly need one byte per arc instead
+ * of four, plus a 12-byte offset and degree entry per vertex.
+ *
+ * Lists are independent, so encoding, decoding and the kernels run in parallel over
+ * vertices. Decoding is sequential within a list; NeighborCursor resumes it one neighbor
+ * at a time, which is what the DFS needs. The graph has the same vertex_count(), degree(),
+ * for_each_neighbor() and cursor() interface as CSRGraph, so breadth_first_visit(),
+ * depth_first_visit() (traversal.hpp) and run_pull() (pagerank.hpp) run on it unchanged.
+ *
+ * Limitation: the only way to build a CompressedGraph is from a CSRGraph, so the
+ * uncompressed graph must fit in memory once (e.g. load_graph(), compress, then drop the
+ * CSRGraph). There is no path that encodes straight from the loader's edge chunks.
+ *
+ * Time Complexity:
+ * - Compression and decompression: O(V + E)
+ * - Visiting the neighbors of v: O(degree(v)); degree(v) itself is O(1)
+ *
+ * Space Complexity: O(V) offsets plus 1-5 bytes per arc (and per weight)
+ */
+
+#ifndef COMPRESSED_GRAPH_HPP
+#define COMPRESSED_GRAPH_HPP
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+#include "csr_graph.hpp"
+#include "traversal.hpp"
+#include "pagerank.hpp"
+#include "../other/parallel_for.hpp"
+
+namespace compressed_detail {
+
+inline size_t varint_size(uint64_t value) {
+    size_t bytes = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        bytes++;
+    }
+    return bytes;
+}
+
+inline uint8_t* write_varint(uint8_t* out, uint64_t value) {
+    while (value >= 0x80) {
+        *out++ = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<uint8_t>(value);
+    return out;
+}
+
+inline const uint8_t* read_varint(const uint8_t* in, uint64_t& value) {
+    // One-byte values dominate, so test for them before entering the loop
+    if (*in < 0x80) {
+        value = *in;
+        return in + 1;
+    }
+    value = 0;
+    unsigned shift = 0;
+    while (*in & 0x80) {
+        value |= static_cast<uint64_t>(*in++ & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= static_cast<uint64_t>(*in++) << shift;
+    return in;
+}
+
+inline uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Encoded size of one list or, with out set, write it
+inline size_t encode_list(uint32_t vertex, std::span<const uint32_t> neighbors, std::span<const int> weights,
+                          uint8_t* out) {
+    size_t bytes = 0;
+    int64_t previous = vertex;
+    for (size_t i = 0; i < neighbors.size(); ++i) {
+        uint64_t gap = i == 0 ? zigzag(static_cast<int64_t>(neighbors[0]) - previous)
+                              : static_cast<uint64_t>(neighbors[i] - previous - 1);
+        previous = neighbors[i];
+        if (out) {
+            out = write_varint(out, gap);
+        }
+        bytes += varint_size(gap);
+        if (!weights.empty()) {
+            uint64_t weight = zigzag(weights[i]);
+            if (out) {
+                out = write_varint(out, weight);
+            }
+            bytes += varint_size(weight);
+        }
+    }
+    return bytes;
+}
+
+} // namespace compressed_detail
+
+/**
+ * @class NeighborCursor
+ * @brief Incremental decoder over one compressed neighbor list
+ */
+class NeighborCursor {
+private:
+    const uint8_t* position = nullptr;
+    uint64_t remaining = 0;
+    int64_t previous = 0;
+    bool first = true;
+    bool weighted = false;
+
+public:
+    NeighborCursor() = default;
+
+    NeighborCursor(const uint8_t* list, uint32_t vertex, uint64_t degree, bool weighted)
+        : position(list), remaining(degree), previous(vertex), weighted(weighted) {}
+
+    /**
+     * @brief Check if neighbors are left to decode
+     */
+    bool has_next() const {
+        return remaining != 0;
+    }
+
+    /**
+     * @brief Get the number of neighbors left to decode
+     */
+    uint64_t left() const {
+        return remaining;
+    }
+
+    /**
+     * @brief Decode the next neighbor
+     * @param weight Receives the arc weight (1 for an unweighted graph)
+     * @return The neighbor ID
+     */
+    uint32_t next(int& weight) {
+        uint64_t gap;
+        position = compressed_detail::read_varint(position, gap);
+        if (first) {
+            previous += compressed_detail::unzigzag(gap);
+            first = false;
+        } else {
+            previous += static_cast<int64_t>(gap) + 1;
+        }
+        weight = 1;
+        if (weighted) {
+            uint64_t encoded;
+            position = compressed_detail::read_varint(position, encoded);
+            weight = static_cast<int>(compressed_detail::unzigzag(encoded));
+        }
+        remaining--;
+        return static_cast<uint32_t>(previous);
+    }
+
+    /**
+     * @brief Decode the next neighbor, ignoring its weight
+     * @return The neighbor ID
+     */
+    uint32_t next() {
+        int weight;
+        return next(weight);
+    }
+};
+
+class CompressedGraph {
+private:
+    std::vector<uint64_t> offset_array;   // Byte offset of each list; V + 1 entries
+    std::vector<uint32_t> degree_array;
+    std::vector<uint8_t> data;
+    uint64_t arcs = 0;
+    bool directed = false;
+    bool weighted = false;
+
+public:
+    /**
+     * @brief Default constructor: an empty undirected graph
+     */
+    CompressedGraph() : offset_array(1, 0) {}
+
+    /**
+     * @brief Compress a CSR graph
+     * @param graph The graph; neighbor lists must be sorted and free of duplicates
+     * @param threads Worker threads (0 means default_thread_count())
+     * @throw std::invalid_argument if a neighbor list is not strictly increasing
+     */
+    explicit CompressedGraph(const CSRGraph& graph, size_t threads = 0)
+        : arcs(graph.arc_count()), directed(graph.is_directed()), weighted(graph.is_weighted()) {
+        size_t n = graph.vertex_count();
+        offset_array.assign(n + 1, 0);
+        degree_array.resize(n);
+
+        // Size every list in parallel, prefix-sum the sizes, then encode in parallel
+        std::vector<uint8_t> sorted(n, 1);
+        parallel_for(0, n, [&](size_t v) {
+            auto neighbors = graph.neighbors(static_cast<uint32_t>(v));
+            for (size_t i = 1; i < neighbors.size(); ++i) {
+                if (neighbors[i] <= neighbors[i - 1]) {
+                    sorted[v] = 0;
+                }
+            }
+            degree_array[v] = static_cast<uint32_t>(neighbors.size());
+            offset_array[v + 1] = compressed_detail::encode_list(static_cast<uint32_t>(v), neighbors,
+                                                                 graph.neighbor_weights(static_cast<uint32_t>(v)),
+                                                                 nullptr);
+        }, 4096, threads);
+        if (std::find(sorted.begin(), sorted.end(), 0) != sorted.end()) {
+            throw std::invalid_argument("Neighbor lists must be strictly increasing to be compressed");
+        }
+        for (size_t v = 0; v < n; ++v) {
+            offset_array[v + 1] += offset_array[v];
+        }
+
+        data.resize(offset_array[n]);
+        parallel_for(0, n, [&](size_t v) {
+            auto neighbors = graph.neighbors(static_cast<uint32_t>(v));
+            compressed_detail::encode_list(static_cast<uint32_t>(v), neighbors,
+                                           graph.neighbor_weights(static_cast<uint32_t>(v)),
+                                           data.data() + offset_array[v]);
+        }, 4096, threads);
+    }
+
+    /**
+     * @brief Get the number of vertices
+     * @return The number of vertices
+     */
+    size_t vertex_count() const {
+        return offset_array.size() - 1;
+    }
+
+    /**
+     * @brief Get the number of stored arcs
+     * @return The number of arcs
+     */
+    size_t arc_count() const {
+        return arcs;
+    }
+
+    /**
+     * @brief Check if the graph is directed
+     * @return true if the graph is directed, false otherwise
+     */
+    bool is_directed() const {
+        return directed;
+    }
+
+    /**
+     * @brief Check if the graph stores explicit weights
+     * @return false if every arc has weight 1
+     */
+    bool is_weighted() const {
+        return weighted;
+    }
+
+    /**
+     * @brief Get the out-degree of a vertex
+     * @param vertex The vertex ID
+     * @return The number of arcs leaving the vertex
+     */
+    size_t degree(uint32_t vertex) const {
+        return degree_array[vertex];
+    }
+
+    /**
+     * @brief Start decoding the neighbors of a vertex
+     * @param vertex The vertex ID
+     * @return A cursor over the neighbors in ascending order
+     */
+    NeighborCursor cursor(uint32_t vertex) const {
+        return NeighborCursor(data.data() + offset_array[vertex], vertex, degree_array[vertex], weighted);
+    }
+
+    /**
+     * @brief Call f(neighbor, weight) for every arc leaving a vertex, in ascending neighbor order
+     * @param vertex The vertex ID
+     * @param f The callback; if it returns bool, returning false stops the scan
+     * @return false if the callback stopped the scan, true otherwise
+     */
+    template<typename F>
+    bool for_each_neighbor(uint32_t vertex, F&& f) const {
+        NeighborCursor it = cursor(vertex);
+        while (it.has_next()) {
+            int weight;
+            uint32_t neighbor = it.next(weight);
+            if (!csr_detail::visit_neighbor(f, neighbor, weight)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Decode the neighbors of a vertex into a vector
+     * @param vertex The vertex ID
+     * @return The neighbor IDs in ascending order
+     */
+    std::vector<uint32_t> neighbors(uint32_t vertex) const {
+        std::vector<uint32_t> result;
+        result.reserve(degree(vertex));
+        for_each_neighbor(vertex, [&](uint32_t neighbor, int) { result.push_back(neighbor); });
+        return result;
+    }
+
+    /**
+     * @brief Decompress back into a CSR graph
+     * @param threads Worker threads (0 means default_thread_count())
+     * @return The equivalent CSR graph
+     */
+    CSRGraph decompress(size_t threads = 0) const {
+        size_t n = vertex_count();
+        std::vector<uint64_t> offsets(n + 1, 0);
+        for (size_t v = 0; v < n; ++v) {
+            offsets[v + 1] = offsets[v] + degree_array[v];
+        }
+        std::vector<uint32_t> targets(arcs);
+        std::vector<int> weights(weighted ? arcs : 0);
+        parallel_for(0, n, [&](size_t v) {
+            uint64_t slot = offsets[v];
+            for_each_neighbor(static_cast<uint32_t>(v), [&](uint32_t neighbor, int weight) {
+                targets[slot] = neighbor;
+                if (weighted) {
+                    weights[slot] = weight;
+                }
+                slot++;
+            });
+        }, 4096, threads);
+        return CSRGraph(std::move(offsets), std::move(targets), std::move(weights), directed);
+    }
+
+    /**
+     * @brief Get the memory used by the compressed arrays
+     * @return The number of bytes
+     */
+    size_t memory_bytes() const {
+        return offset_array.size() * sizeof(uint64_t) + degree_array.size() * sizeof(uint32_t) + data.size();
+    }
+
+    /**
+     * @brief Get the average encoded size of an arc, including its weight
+     * @return Bytes per arc in the encoded stream
+     */
+    double bytes_per_arc() const {
+        return arcs == 0 ? 0.0 : static_cast<double>(data.size()) / static_cast<double>(arcs);
+    }
+};
+
+/**
+ * @brief Compute PageRank on a compressed graph with the pull kernel
+ * @param graph The graph
+ * @param transposed The compressed transpose of a directed graph (ignored for an undirected graph)
+ * @param damping Probability of following an arc rather than teleporting
+ * @param options Stopping criteria and thread count
+ * @return PageRank scores summing to 1; dangling vertices teleport uniformly
+ */
+inline IterationResult pagerank(const CompressedGraph& graph, const CompressedGraph& transposed,
+                                double damping = 0.85, const IterationOptions& options = {}) {
+    return pagerank_detail::pull(graph, graph.is_directed() ? transposed : graph, {}, damping, options);
+}
+
+/**
+ * @brief Compute PageRank on an undirected compressed graph with the pull kernel
+ * @param graph The graph
+ * @param damping Probability of following an arc rather than teleporting
+ * @param options Stopping criteria and thread count
+ * @return PageRank scores summing to 1
+ * @throw std::invalid_argument if the graph is directed (pass its compressed transpose instead)
+ */
+inline IterationResult pagerank(const CompressedGraph& graph, double damping = 0.85,
+                                const IterationOptions& options = {}) {
+    if (graph.is_directed()) {
+        throw std::invalid_argument("PageRank on a directed compressed graph needs its compressed transpose");
+    }
+    return pagerank(graph, graph, damping, options);
+}
+
+#endif // COMPRESSED_GRAPH_HPP
@@ -0,0 +1,742 @@
+/**
+ * @file contraction_hierarchy.hpp
+ * @brief Contraction hierarchies for fast repeated point-to-point shortest-path queries
+ *
+ * Preprocessing contracts vertices one level at a time. When a vertex v is removed,
+ * every path u -> v -> w that is the only shortest u-w path among the remaining
+ * vertices is replaced by a shortcut arc u -> w (a witness search, i.e. a bounded local
+ * Dijkstra from u that avoids v, decides this). Each level is the set of vertices whose
+ * priority is smaller than that of every vertex within two hops, so its witness searches
+ * run in parallel; witnesses avoid every vertex of the level, which keeps the
+ * concurrently added shortcuts correct. The priority is twice the edge difference
+ * (shortcuts added minus arcs removed), plus the number of contracted neighbors and
+ * twice the depth in the hierarchy, which spread contraction evenly over the graph.
+ * Priorities of the neighbors of a level are re-estimated in parallel afterwards.
+ *
+ * Every vertex keeps the arcs it had to higher-ranked vertices when it was contracted
+ * (the upward graph, in both directions). A query runs Dijkstra upward from the source
+ * and, on reversed arcs, upward from the target; the shortest path meets at its
+ * highest-ranked vertex. Vertices that a higher-ranked vertex reaches more cheaply are
+ * not expanded (stall-on-demand). Only a few hundred vertices are settled on road-like
+ * graphs; grids are the hard case, as their large separators end up as a dense top core.
+ * Shortcuts remember the vertex they bypass, so paths are unpacked into original arcs.
+ *
+ * The hierarchy can be saved to and loaded from a binary file.
+ *
+ * Time Complexity:
+ * - Preprocessing: depends on the graph; near-linear on road-like graphs
+ * - Query: O(k log k) for the k vertices settled in the upward searches
+ *
+ * Space Complexity: O(V + E + shortcuts)
+ */
+
+#ifndef CONTRACTION_HIERARCHY_HPP
+#define CONTRACTION_HIERARCHY_HPP
+
+#include <vector>
+#include <queue>
+#include <tuple>
+#include <string>
+#include <limits>
+#include <cstdint>
+#include <fstream>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include <stdexcept>
+
+#include "csr_graph.hpp"
+#include "../other/parallel_for.hpp"
+
+/**
+ * @brief Tuning knobs for ContractionHierarchy preprocessing
+ */
+struct ContractionOptions {
+    size_t threads = 0;                 // Worker threads (0 means default_thread_count())
+    size_t witness_settle_limit = 500;  // Vertices a witness search may settle before giving up (adds a shortcut)
+    size_t priority_settle_limit = 50;  // The same limit for the simulated contractions that estimate priorities
+};
+
+namespace contraction_detail {
+
+inline constexpr uint32_t NO_VERTEX = std::numeric_limits<uint32_t>::max();
+inline constexpr int64_t INF = std::numeric_limits<int64_t>::max();
+
+struct DynamicArc {
+    uint32_t target;
+    uint32_t middle;    // Bypassed vertex of a shortcut, NO_VERTEX for an original arc
+    int64_t weight;
+};
+
+struct Shortcut {
+    uint32_t from;
+    uint32_t to;
+    int64_t weight;
+};
+
+// Scratch for one thread's witness searches: versioned distances and a heap
+class WitnessSearch {
+private:
+    std::vector<int64_t> distance;
+    std::vector<uint32_t> stamp;
+    std::vector<uint32_t> target_stamp;
+    uint32_t epoch = 0;
+    std::priority_queue<std::pair<int64_t, uint32_t>, std::vector<std::pair<int64_t, uint32_t>>,
+                        std::greater<>> heap;
+
+public:
+    explicit WitnessSearch(size_t n) : distance(n), stamp(n, 0), target_stamp(n, 0) {}
+
+    int64_t get(uint32_t v) const {
+        return stamp[v] == epoch ? distance[v] : INF;
+    }
+
+    // Distances from source over out-arcs, avoiding excluded vertices, up to limit.
+    // Stops early once the targets (the out-neighbors of the vertex being contracted) are settled.
+    template<typename Excluded>
+    void run(const std::vector<DynamicArc>& targets, const std::vector<std::vector<DynamicArc>>& out,
+             uint32_t source, int64_t limit, size_t settle_limit, Excluded excluded) {
+        if (++epoch == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            std::fill(target_stamp.begin(), target_stamp.end(), 0);
+            epoch = 1;
+        }
+        size_t unsettled = 0;
+        for (const DynamicArc& arc : targets) {
+            if (target_stamp[arc.target] != epoch) {
+                target_stamp[arc.target] = epoch;
+                unsettled++;
+            }
+        }
+        heap = {};
+        stamp[source] = epoch;
+        distance[source] = 0;
+        heap.emplace(0, source);
+        size_t settled = 0;
+        while (!heap.empty()) {
+            auto [d, u] = heap.top();
+            heap.pop();
+            if (d > get(u)) {
+                continue;
+            }
+            if (d > limit || ++settled > settle_limit) {
+                break;
+            }
+            if (target_stamp[u] == epoch && --unsettled == 0) {
+                break;
+            }
+            for (const DynamicArc& arc : out[u]) {
+                if (excluded(arc.target)) {
+                    continue;
+                }
+                int64_t candidate = d + arc.weight;
+                if (candidate < get(arc.target)) {
+                    stamp[arc.target] = epoch;
+                    distance[arc.target] = candidate;
+                    heap.emplace(candidate, arc.target);
+                }
+            }
+        }
+    }
+};
+
+} // namespace contraction_detail
+
+/**
+ * @class ContractionHierarchy
+ * @brief Vertex ranks and upward graphs of a preprocessed graph; query it through ContractionHierarchyQuery
+ */
+class ContractionHierarchy {
+private:
+    // Upward graphs in CSR form. forward: arcs v -> x with rank[x] > rank[v].
+    // backward: for original arcs x -> v with rank[x] > rank[v], stored at v.
+    struct UpwardGraph {
+        std::vector<uint64_t> offsets;
+        std::vector<uint32_t> targets;
+        std::vector<int64_t> weights;
+        std::vector<uint32_t> middles;
+    };
+
+    UpwardGraph forward;
+    UpwardGraph backward;
+    std::vector<uint32_t> rank_array;
+    size_t shortcuts = 0;
+
+    friend class ContractionHierarchyQuery;
+
+    ContractionHierarchy() = default;
+
+    using Lists = std::vector<std::vector<contraction_detail::DynamicArc>>;
+
+    static void remove_arc(std::vector<contraction_detail::DynamicArc>& list, uint32_t target) {
+        list.erase(std::remove_if(list.begin(), list.end(), [&](const auto& arc) { return arc.target == target; }),
+                   list.end());
+    }
+
+    // Insert or shorten u -> w, keeping out and in lists in sync; returns true if it changed anything
+    static bool relax_arc(Lists& out, Lists& in, uint32_t u, uint32_t w, int64_t weight, uint32_t middle) {
+        for (auto& arc : out[u]) {
+            if (arc.target == w) {
+                if (arc.weight <= weight) {
+                    return false;
+                }
+                arc.weight = weight;
+                arc.middle = middle;
+                for (auto& back : in[w]) {
+                    if (back.target == u) {
+                        back.weight = weight;
+                        back.middle = middle;
+                    }
+                }
+                return true;
+            }
+        }
+        out[u].push_back({w, middle, weight});
+        in[w].push_back({u, middle, weight});
+        return true;
+    }
+
+    // Shortcuts needed to contract v when witnesses must avoid excluded vertices
+    template<typename Excluded>
+    static void find_shortcuts(const Lists& out, const Lists& in, uint32_t v, size_t settle_limit,
+                               contraction_detail::WitnessSearch& search, Excluded excluded,
+                               std::vector<contraction_detail::Shortcut>& result) {
+        result.clear();
+        int64_t longest_out = 0;
+        for (const auto& arc : out[v]) {
+            longest_out = std::max(longest_out, arc.weight);
+        }
+        for (const auto& incoming : in[v]) {
+            uint32_t u = incoming.target;
+            search.run(out[v], out, u, incoming.weight + longest_out, settle_limit, [&](uint32_t x) {
+                return x == v || excluded(x);
+            });
+            for (const auto& outgoing : out[v]) {
+                uint32_t w = outgoing.target;
+                int64_t via = incoming.weight + outgoing.weight;
+                if (w != u && search.get(w) > via) {
+                    result.push_back({u, w, via});
+                }
+            }
+        }
+    }
+
+    static UpwardGraph pack(std::vector<std::vector<contraction_detail::DynamicArc>>& lists) {
+        UpwardGraph graph;
+        graph.offsets.assign(lists.size() + 1, 0);
+        for (size_t v = 0; v < lists.size(); ++v) {
+            graph.offsets[v + 1] = graph.offsets[v] + lists[v].size();
+        }
+        for (auto& list : lists) {
+            for (const auto& arc : list) {
+                graph.targets.push_back(arc.target);
+                graph.weights.push_back(arc.weight);
+                graph.middles.push_back(arc.middle);
+            }
+            list = {};
+        }
+        return graph;
+    }
+
+    template<typename Value>
+    static void write_vector(std::ofstream& out, const std::vector<Value>& values) {
+        uint64_t size = values.size();
+        out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(size * sizeof(Value)));
+    }
+
+    // file_size bounds the element count, so a corrupt length cannot trigger a huge allocation
+    template<typename Value>
+    static bool read_vector(std::ifstream& in, uint64_t file_size, std::vector<Value>& values) {
+        uint64_t size = 0;
+        in.read(reinterpret_cast<char*>(&size), sizeof(size));
+        if (!in) {
+            return false;
+        }
+        uint64_t left = file_size - static_cast<uint64_t>(in.tellg());
+        if (size > left / sizeof(Value)) {
+            return false;
+        }
+        values.resize(size);
+        in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(size * sizeof(Value)));
+        return static_cast<bool>(in);
+    }
+
+    // Check that offsets index targets and that every arc endpoint and middle is a vertex
+    static bool valid_upward(const UpwardGraph& graph, uint64_t n) {
+        const auto& offsets = graph.offsets;
+        if (offsets.size() != n + 1 || offsets.front() != 0 || offsets.back() != graph.targets.size() ||
+            graph.weights.size() != graph.targets.size() || graph.middles.size() != graph.targets.size()) {
+            return false;
+        }
+        for (size_t v = 0; v < n; ++v) {
+            if (offsets[v] > offsets[v + 1]) {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < graph.targets.size(); ++i) {
+            if (graph.targets[i] >= n ||
+                (graph.middles[i] != contraction_detail::NO_VERTEX && graph.middles[i] >= n)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static constexpr uint64_t FILE_MAGIC = 0x3130484354524f43ull;   // "CORTCH01"
+
+public:
+    /**
+     * @brief Preprocess a graph into a contraction hierarchy
+     * @param graph The graph (directed or undirected, non-negative weights)
+     * @param options Thread count and witness search limit
+     * @throw std::invalid_argument if a weight is negative
+     */
+    explicit ContractionHierarchy(const CSRGraph& graph, const ContractionOptions& options = {}) {
+        using namespace contraction_detail;
+        size_t n = graph.vertex_count();
+        size_t threads = options.threads == 0 ? default_thread_count() : options.threads;
+
+        Lists out(n);
+        Lists in(n);
+        for (uint32_t u = 0; u < n; ++u) {
+            auto neighbors = graph.neighbors(u);
+            auto weights = graph.neighbor_weights(u);
+            for (size_t i = 0; i < neighbors.size(); ++i) {
+                int64_t weight = weights.empty() ? 1 : weights[i];
+                if (weight < 0) {
+                    throw std::invalid_argument("Contraction hierarchies require non-negative weights");
+                }
+                if (neighbors[i] != u) {
+                    relax_arc(out, in, u, neighbors[i], weight, NO_VERTEX);
+                }
+            }
+        }
+
+        std::vector<WitnessSearch> searches;
+        searches.reserve(threads);
+        for (size_t t = 0; t < threads; ++t) {
+            searches.emplace_back(n);
+        }
+        std::vector<std::vector<Shortcut>> scratch(threads);
+        std::vector<std::vector<Shortcut>> pending(n);
+        std::vector<int64_t> priority(n, 0);
+        std::vector<uint32_t> contracted_neighbors(n, 0);
+        std::vector<uint32_t> depth(n, 0);
+        std::vector<uint8_t> in_level(n, 0);
+        std::vector<uint8_t> contracted(n, 0);
+
+        auto update_priorities = [&](const std::vector<uint32_t>& vertices) {
+            parallel_for_blocks(0, vertices.size(), 64, [&](size_t lo, size_t hi, size_t worker) {
+                for (size_t i = lo; i < hi; ++i) {
+                    uint32_t v = vertices[i];
+                    find_shortcuts(out, in, v, options.priority_settle_limit, searches[worker],
+                                   [](uint32_t) { return false; }, scratch[worker]);
+                    int64_t removed = static_cast<int64_t>(out[v].size() + in[v].size());
+                    int64_t added = static_cast<int64_t>(scratch[worker].size());
+                    priority[v] = 2 * (added - removed) + contracted_neighbors[v] + 2 * depth[v];
+                }
+            }, threads);
+        };
+
+        std::vector<uint32_t> remaining(n);
+        for (uint32_t v = 0; v < n; ++v) {
+            remaining[v] = v;
+        }
+        update_priorities(remaining);
+
+        // Ties are broken by a hash of the ID, so that levels do not sweep the graph in ID order
+        auto before = [&](uint32_t a, uint32_t b) {
+            if (priority[a] != priority[b]) {
+                return priority[a] < priority[b];
+            }
+            uint64_t ha = (a * 0x9e3779b97f4a7c15ull) >> 17;
+            uint64_t hb = (b * 0x9e3779b97f4a7c15ull) >> 17;
+            return ha != hb ? ha < hb : a < b;
+        };
+
+        rank_array.assign(n, 0);
+        Lists up_forward(n);
+        Lists up_backward(n);
+        uint32_t next_rank = 0;
+        std::vector<uint32_t> level;
+        std::vector<uint8_t> is_selected(n, 0);
+
+        while (!remaining.empty()) {
+            // Independent set: vertices that come before every remaining vertex within two hops
+            parallel_for(0, remaining.size(), [&](size_t i) {
+                uint32_t v = remaining[i];
+                bool minimal = true;
+                auto check = [&](uint32_t x) {
+                    for (const auto& arc : out[x]) {
+                        minimal = minimal && (arc.target == v || before(v, arc.target));
+                    }
+                    for (const auto& arc : in[x]) {
+                        minimal = minimal && (arc.target == v || before(v, arc.target));
+                    }
+                };
+                check(v);
+                for (const auto& arc : out[v]) {
+                    if (minimal) {
+                        check(arc.target);
+                    }
+                }
+                for (const auto& arc : in[v]) {
+                    if (minimal) {
+                        check(arc.target);
+                    }
+                }
+                is_selected[v] = minimal;
+            }, 1024, threads);
+            level.clear();
+            for (uint32_t v : remaining) {
+                if (is_selected[v]) {
+                    level.push_back(v);
+                    in_level[v] = 1;
+                }
+            }
+
+            parallel_for_blocks(0, level.size(), 16, [&](size_t lo, size_t hi, size_t worker) {
+                for (size_t i = lo; i < hi; ++i) {
+                    uint32_t v = level[i];
+                    find_shortcuts(out, in, v, options.witness_settle_limit, searches[worker],
+                                   [&](uint32_t x) { return in_level[x] != 0; }, pending[v]);
+                }
+            }, threads);
+
+            std::vector<uint32_t> touched;
+            for (uint32_t v : level) {
+                rank_array[v] = next_rank++;
+                contracted[v] = 1;
+                up_forward[v] = out[v];
+                up_backward[v] = in[v];
+                for (const auto& arc : out[v]) {
+                    remove_arc(in[arc.target], v);
+                    touched.push_back(arc.target);
+                    depth[arc.target] = std::max(depth[arc.target], depth[v] + 1);
+                }
+                for (const auto& arc : in[v]) {
+                    remove_arc(out[arc.target], v);
+                    touched.push_back(arc.target);
+                    depth[arc.target] = std::max(depth[arc.target], depth[v] + 1);
+                }
+                out[v] = {};
+                in[v] = {};
+                for (const auto& shortcut : pending[v]) {
+                    if (relax_arc(out, in, shortcut.from, shortcut.to, shortcut.weight, v)) {
+                        shortcuts++;
+                    }
+                }
+                pending[v] = {};
+                in_level[v] = 0;
+            }
+
+            std::sort(touched.begin(), touched.end());
+            touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+            for (uint32_t x : touched) {
+                contracted_neighbors[x]++;
+            }
+            update_priorities(touched);
+            remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                           [&](uint32_t v) { return contracted[v] != 0; }),
+                            remaining.end());
+        }
+
+        forward = pack(up_forward);
+        backward = pack(up_backward);
+    }
+
+    /**
+     * @brief Get the number of vertices
+     */
+    size_t vertex_count() const {
+        return rank_array.size();
+    }
+
+    /**
+     * @brief Get the number of shortcut arcs added during preprocessing
+     */
+    size_t shortcut_count() const {
+        return shortcuts;
+    }
+
+    /**
+     * @brief Get the contraction rank of a vertex (0 was contracted first)
+     * @param vertex The vertex ID
+     * @return The rank
+     */
+    uint32_t rank(uint32_t vertex) const {
+        return rank_array[vertex];
+    }
+
+    /**
+     * @brief Write the hierarchy to a binary file
+     * @param path The output file
+     * @throw std::runtime_error if the file cannot be written
+     */
+    void save(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        uint64_t magic = FILE_MAGIC;
+        uint64_t shortcut_total = shortcuts;
+        out.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+        out.write(reinterpret_cast<const char*>(&shortcut_total), sizeof(shortcut_total));
+        write_vector(out, rank_array);
+        for (const UpwardGraph* graph : {&forward, &backward}) {
+            write_vector(out, graph->offsets);
+            write_vector(out, graph->targets);
+            write_vector(out, graph->weights);
+            write_vector(out, graph->middles);
+        }
+        if (!out) {
+            throw std::runtime_error("Cannot write contraction hierarchy to " + path);
+        }
+    }
+
+    /**
+     * @brief Read a hierarchy written by save()
+     * @param path The input file
+     * @return The hierarchy
+     * @throw std::runtime_error if the file cannot be read or is not a valid hierarchy
+     */
+    static ContractionHierarchy load(const std::string& path) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        uint64_t file_size = in ? static_cast<uint64_t>(in.tellg()) : 0;
+        in.seekg(0);
+        uint64_t magic = 0;
+        uint64_t shortcut_total = 0;
+        in.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+        in.read(reinterpret_cast<char*>(&shortcut_total), sizeof(shortcut_total));
+        if (!in || magic != FILE_MAGIC) {
+            throw std::runtime_error("Not a contraction hierarchy file: " + path);
+        }
+        ContractionHierarchy hierarchy;
+        hierarchy.shortcuts = static_cast<size_t>(shortcut_total);
+        bool valid = read_vector(in, file_size, hierarchy.rank_array);
+        uint64_t n = hierarchy.rank_array.size();
+        for (UpwardGraph* graph : {&hierarchy.forward, &hierarchy.backward}) {
+            valid = valid && read_vector(in, file_size, graph->offsets) && read_vector(in, file_size, graph->targets) &&
+                    read_vector(in, file_size, graph->weights) && read_vector(in, file_size, graph->middles) &&
+                    valid_upward(*graph, n);
+        }
+        if (!valid) {
+            throw std::runtime_error("Corrupt contraction hierarchy file: " + path);
+        }
+        return hierarchy;
+    }
+};
+
+/**
+ * @class ContractionHierarchyQuery
+ * @brief Reusable query state for a ContractionHierarchy (one per thread)
+ */
+class ContractionHierarchyQuery {
+private:
+    using Heap = std::priority_queue<std::pair<int64_t, uint32_t>, std::vector<std::pair<int64_t, uint32_t>>,
+                                     std::greater<>>;
+
+    struct Side {
+        std::vector<int64_t> distance;
+        std::vector<uint64_t> parent_arc;   // Arc index in the side's upward graph
+        std::vector<uint32_t> parent;
+        std::vector<uint32_t> stamp;
+        Heap heap;
+    };
+
+    const ContractionHierarchy& hierarchy;
+    Side sides[2];
+    uint32_t epoch = 0;
+    uint32_t meeting = contraction_detail::NO_VERTEX;
+    size_t settled = 0;
+
+    int64_t get(const Side& side, uint32_t v) const {
+        return side.stamp[v] == epoch ? side.distance[v] : contraction_detail::INF;
+    }
+
+    // Append the original vertices of arc a -> b (excluding a) to path
+    void unpack(uint32_t a, uint32_t b, int64_t weight, uint32_t middle, std::vector<uint32_t>& path) const {
+        const auto& up = hierarchy.forward;
+        const auto& down = hierarchy.backward;
+        std::vector<std::tuple<uint32_t, uint32_t, int64_t, uint32_t>> stack = {{a, b, weight, middle}};
+        while (!stack.empty()) {
+            auto [from, to, w, m] = stack.back();
+            stack.pop_back();
+            if (m == contraction_detail::NO_VERTEX) {
+                path.push_back(to);
+                continue;
+            }
+            // from -> m is stored at m in the backward graph, m -> to at m in the forward graph
+            bool found = false;
+            for (uint64_t i = down.offsets[m]; i < down.offsets[m + 1] && !found; ++i) {
+                if (down.targets[i] != from) {
+                    continue;
+                }
+                for (uint64_t j = up.offsets[m]; j < up.offsets[m + 1]; ++j) {
+                    if (up.targets[j] == to && down.weights[i] + up.weights[j] == w) {
+                        stack.emplace_back(m, to, up.weights[j], up.middles[j]);
+                        stack.emplace_back(from, m, down.weights[i], down.middles[i]);
+                        found = true;
+                        break;
+                    }
+                }
+            }
+            if (!found) {
+                throw std::runtime_error("Inconsistent shortcut in contraction hierarchy");
+            }
+        }
+    }
+
+public:
+    explicit ContractionHierarchyQuery(const ContractionHierarchy& hierarchy) : hierarchy(hierarchy) {
+        for (Side& side : sides) {
+            side.distance.resize(hierarchy.vertex_count());
+            side.parent_arc.resize(hierarchy.vertex_count());
+            side.parent.resize(hierarchy.vertex_count());
+            side.stamp.assign(hierarchy.vertex_count(), 0);
+        }
+    }
+
+    /**
+     * @brief Compute the shortest-path distance between two vertices
+     * @param source The source vertex ID
+     * @param target The target vertex ID
+     * @return The distance, or INT64_MAX if the target is unreachable
+     * @throw std::out_of_range if a vertex ID is out of range
+     */
+    int64_t distance(uint32_t source, uint32_t target) {
+        using contraction_detail::INF;
+        if (source >= hierarchy.vertex_count() || target >= hierarchy.vertex_count()) {
+            throw std::out_of_range("Vertex ID is out of range");
+        }
+        if (++epoch == 0) {
+            for (Side& side : sides) {
+                std::fill(side.stamp.begin(), side.stamp.end(), 0);
+            }
+            epoch = 1;
+        }
+        settled = 0;
+        meeting = contraction_detail::NO_VERTEX;
+        int64_t best = INF;
+        const ContractionHierarchy::UpwardGraph* graphs[2] = {&hierarchy.forward, &hierarchy.backward};
+        uint32_t starts[2] = {source, target};
+        for (int s = 0; s < 2; ++s) {
+            Side& side = sides[s];
+            side.heap = {};
+            side.stamp[starts[s]] = epoch;
+            side.distance[starts[s]] = 0;
+            side.parent[starts[s]] = contraction_detail::NO_VERTEX;
+            side.heap.emplace(0, starts[s]);
+        }
+
+        while (true) {
+            // Expand the side with the smaller key; a side is done once its key reaches best
+            int s = -1;
+            for (int candidate = 0; candidate < 2; ++candidate) {
+                Heap& heap = sides[candidate].heap;
+                if (!heap.empty() && heap.top().first < best &&
+                    (s < 0 || heap.top().first < sides[s].heap.top().first)) {
+                    s = candidate;
+                }
+            }
+            if (s < 0) {
+                break;
+            }
+            Side& side = sides[s];
+            auto [d, u] = side.heap.top();
+            side.heap.pop();
+            if (d > get(side, u)) {
+                continue;
+            }
+            settled++;
+            int64_t other = get(sides[1 - s], u);
+            if (other != INF && d + other < best) {
+                best = d + other;
+                meeting = u;
+            }
+            // Stall-on-demand: if a higher-ranked vertex already reached reaches u more cheaply,
+            // d is not a shortest distance and u need not be expanded
+            const auto& opposite = *graphs[1 - s];
+            bool stalled = false;
+            for (uint64_t arc = opposite.offsets[u]; arc < opposite.offsets[u + 1] && !stalled; ++arc) {
+                int64_t via = get(side, opposite.targets[arc]);
+                stalled = via != INF && via + opposite.weights[arc] < d;
+            }
+            if (stalled) {
+                continue;
+            }
+            const auto& graph = *graphs[s];
+            for (uint64_t arc = graph.offsets[u]; arc < graph.offsets[u + 1]; ++arc) {
+                uint32_t x = graph.targets[arc];
+                int64_t candidate = d + graph.weights[arc];
+                if (candidate < get(side, x)) {
+                    side.stamp[x] = epoch;
+                    side.distance[x] = candidate;
+                    side.parent[x] = u;
+                    side.parent_arc[x] = arc;
+                    side.heap.emplace(candidate, x);
+                }
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Compute a shortest path between two vertices
+     * @param source The source vertex ID
+     * @param target The target vertex ID
+     * @return The distance and the original vertices along the path (empty if unreachable)
+     * @throw std::out_of_range if a vertex ID is out of range
+     */
+    std::pair<int64_t, std::vector<uint32_t>> shortest_path(uint32_t source, uint32_t target) {
+        int64_t best = distance(source, target);
+        if (best == contraction_detail::INF) {
+            return {best, {}};
+        }
+        // Upward arcs from the source to the meeting vertex, then from it down to the target
+        std::vector<uint32_t> upward;
+        for (uint32_t v = meeting; v != source; v = sides[0].parent[v]) {
+            upward.push_back(v);
+        }
+        std::vector<uint32_t> path = {source};
+        uint32_t current = source;
+        for (auto it = upward.rbegin(); it != upward.rend(); ++it) {
+            uint64_t arc = sides[0].parent_arc[*it];
+            unpack(current, *it, hierarchy.forward.weights[arc], hierarchy.forward.middles[arc], path);
+            current = *it;
+        }
+        for (uint32_t v = meeting; v != target; v = sides[1].parent[v]) {
+            uint32_t next = sides[1].parent[v];
+            uint64_t arc = sides[1].parent_arc[v];
+            unpack(v, next, hierarchy.backward.weights[arc], hierarchy.backward.middles[arc], path);
+        }
+        return {best, path};
+    }
+
+    /**
+     * @brief Get the number of vertices settled by the last query
+     */
+    size_t settled_count() const {
+        return settled;
+    }
+};
+
+/**
+ * @brief Compute a shortest path between two vertices of a snapshot by key
+ * @param snapshot The frozen graph the hierarchy was built from
+ * @param query Query state of a hierarchy built from snapshot.csr()
+ * @param from The source key
+ * @param to The target key
+ * @return The path length and the keys along the path (empty if unreachable)
+ * @throw std::out_of_range if a key is not in the snapshot
+ */
+template<typename T>
+std::pair<int64_t, std::vector<T>> shortest_path(const GraphSnapshot<T>& snapshot, ContractionHierarchyQuery& query,
+                                                 const T& from, const T& to) {
+    auto [distance, ids] = query.shortest_path(snapshot.id_of(from), snapshot.id_of(to));
+    std::vector<T> path;
+    for (uint32_t v : ids) {
+        path.push_back(snapshot.key_of(v));
+    }
+    return {distance, path};
+}
+
+#endif // CONTRACTION_HIERARCHY_HPP
@@ -0,0 +1,461 @@
+/**
+ * @file csr_graph.hpp
+ * @brief Compressed sparse row (CSR) graph with dense 32-bit vertex IDs
+ *
+ * A CSR graph stores all adjacency lists back to back in one array. The neighbors of
+ * vertex v are targets[offsets[v] .. offsets[v + 1]), sorted by ID, with the matching
+ * edge weights at the same positions of a parallel weights array. The structure is
+ * immutable: it is built once (e.g. by Graph::freeze()) and then scanned sequentially
+ * by the analytics in this directory. Undirected edges are stored as two arcs.
+ *
+ * Time Complexity:
+ * - Build from an edge list: O(V + E)
+ * - Neighbors / degree: O(1)
+ * - Check if edge exists: O(log d)
+ *
+ * Space Complexity: O(V + E), 8 bytes per vertex and 8 bytes per weighted arc
+ */
+
+#ifndef CSR_GRAPH_HPP
+#define CSR_GRAPH_HPP
+
+#include <vector>
+#include <span>
+#include <tuple>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+#include <stdexcept>
+#include <type_traits>
+
+namespace csr_detail {
+
+// Call a for_each_neighbor() callback; a callback returning bool stops the scan with false
+template<typename F>
+bool visit_neighbor(F& f, uint32_t neighbor, int weight) {
+    if constexpr (std::is_same_v<std::invoke_result_t<F&, uint32_t, int>, bool>) {
+        return f(neighbor, weight);
+    } else {
+        f(neighbor, weight);
+        return true;
+    }
+}
+
+} // namespace csr_detail
+
+/**
+ * @class CSRNeighborCursor
+ * @brief Resumable position in one CSR neighbor list (same interface as NeighborCursor)
+ */
+class CSRNeighborCursor {
+private:
+    const uint32_t* position = nullptr;
+    const uint32_t* end = nullptr;
+    const int* weights = nullptr;   // Aligned with position, or nullptr if unweighted
+
+public:
+    CSRNeighborCursor() = default;
+
+    CSRNeighborCursor(const uint32_t* begin, const uint32_t* end, const int* weights)
+        : position(begin), end(end), weights(weights) {}
+
+    /**
+     * @brief Check if neighbors are left
+     */
+    bool has_next() const {
+        return position != end;
+    }
+
+    /**
+     * @brief Get the number of neighbors left
+     */
+    uint64_t left() const {
+        return static_cast<uint64_t>(end - position);
+    }
+
+    /**
+     * @brief Advance to the next neighbor
+     * @param weight Receives the arc weight (1 for an unweighted graph)
+     * @return The neighbor ID
+     */
+    uint32_t next(int& weight) {
+        weight = weights ? *weights++ : 1;
+        return *position++;
+    }
+
+    /**
+     * @brief Advance to the next neighbor, ignoring its weight
+     * @return The neighbor ID
+     */
+    uint32_t next() {
+        if (weights) {
+            weights++;
+        }
+        return *position++;
+    }
+};
+
+class CSRGraph {
+private:
+    std::vector<uint64_t> offset_array;
+    std::vector<uint32_t> target_array;
+    std::vector<int> weight_array;      // Empty when every arc has weight 1
+    bool directed;
+
+public:
+    /**
+     * @brief Default constructor: an empty undirected graph
+     */
+    CSRGraph() : offset_array(1, 0), directed(false) {}
+
+    /**
+     * @brief Construct from prebuilt CSR arrays
+     * @param offsets V + 1 non-decreasing offsets starting at 0 and ending at targets.size()
+     * @param targets Neighbor IDs, sorted within each vertex
+     * @param weights Arc weights aligned with targets, or empty for an unweighted graph
+     * @param directed Whether arcs are one-way; undirected graphs must contain both arcs of each edge
+     * @throw std::invalid_argument if the arrays are inconsistent
+     */
+    CSRGraph(std::vector<uint64_t> offsets, std::vector<uint32_t> targets, std::vector<int> weights, bool directed)
+        : offset_array(std::move(offsets)), target_array(std::move(targets)),
+          weight_array(std::move(weights)), directed(directed) {
+        if (offset_array.empty() || offset_array.front() != 0 || offset_array.back() != target_array.size()) {
+            throw std::invalid_argument("CSR offsets do not match the target array");
+        }
+        if (!weight_array.empty() && weight_array.size() != target_array.size()) {
+            throw std::invalid_argument("CSR weights do not match the target array");
+        }
+    }
+
+    /**
+     * @brief Build a CSR graph from an edge list
+     * @param vertex_count Number of vertices; every endpoint must be below it
+     * @param edges (source, target, weight) tuples
+     * @param directed Whether the edges are one-way; otherwise both arcs are stored
+     * @return The CSR graph with neighbor lists sorted by target ID
+     * @throw std::out_of_range if an endpoint is not below vertex_count
+     */
+    static CSRGraph from_edge_list(size_t vertex_count, const std::vector<std::tuple<uint32_t, uint32_t, int>>& edges,
+                                   bool directed) {
+        std::vector<std::tuple<uint32_t, uint32_t, int>> arcs;
+        arcs.reserve(directed ? edges.size() : 2 * edges.size());
+        for (const auto& [u, v, w] : edges) {
+            if (u >= vertex_count || v >= vertex_count) {
+                throw std::out_of_range("Edge endpoint is not a valid vertex ID");
+            }
+            arcs.emplace_back(u, v, w);
+            if (!directed && u != v) {
+                arcs.emplace_back(v, u, w);
+            }
+        }
+
+        // Two stable counting sorts (by target, then by source) order the arcs by (source, target)
+        auto counting_sort = [&](auto key) {
+            std::vector<uint64_t> start(vertex_count + 1, 0);
+            for (const auto& arc : arcs) {
+                start[key(arc) + 1]++;
+            }
+            for (size_t v = 0; v < vertex_count; ++v) {
+                start[v + 1] += start[v];
+            }
+            std::vector<std::tuple<uint32_t, uint32_t, int>> sorted(arcs.size());
+            for (const auto& arc : arcs) {
+                sorted[start[key(arc)]++] = arc;
+            }
+            arcs.swap(sorted);
+        };
+        counting_sort([](const auto& arc) { return std::get<1>(arc); });
+        counting_sort([](const auto& arc) { return std::get<0>(arc); });
+
+        std::vector<uint64_t> offsets(vertex_count + 1, 0);
+        std::vector<uint32_t> targets(arcs.size());
+        std::vector<int> weights(arcs.size());
+        bool weighted = false;
+        for (size_t i = 0; i < arcs.size(); ++i) {
+            offsets[std::get<0>(arcs[i]) + 1]++;
+            targets[i] = std::get<1>(arcs[i]);
+            weights[i] = std::get<2>(arcs[i]);
+            weighted = weighted || weights[i] != 1;
+        }
+        for (size_t v = 0; v < vertex_count; ++v) {
+            offsets[v + 1] += offsets[v];
+        }
+        if (!weighted) {
+            weights.clear();
+        }
+        return CSRGraph(std::move(offsets), std::move(targets), std::move(weights), directed);
+    }
+
+    /**
+     * @brief Get the number of vertices
+     * @return The number of vertices
+     */
+    size_t vertex_count() const {
+        return offset_array.size() - 1;
+    }
+
+    /**
+     * @brief Get the number of stored arcs (an undirected edge counts twice, a self-loop once)
+     * @return The number of arcs
+     */
+    size_t arc_count() const {
+        return target_array.size();
+    }
+
+    /**
+     * @brief Check if the graph is directed
+     * @return true if the graph is directed, false otherwise
+     */
+    bool is_directed() const {
+        return directed;
+    }
+
+    /**
+     * @brief Check if the graph stores explicit weights
+     * @return false if every arc has weight 1
+     */
+    bool is_weighted() const {
+        return !weight_array.empty();
+    }
+
+    /**
+     * @brief Get the out-degree of a vertex
+     * @param vertex The vertex ID
+     * @return The number of arcs leaving the vertex
+     */
+    size_t degree(uint32_t vertex) const {
+        return offset_array[vertex + 1] - offset_array[vertex];
+    }
+
+    /**
+     * @brief Get the neighbors of a vertex without copying
+     * @param vertex The vertex ID
+     * @return A view of the neighbor IDs in ascending order
+     */
+    std::span<const uint32_t> neighbors(uint32_t vertex) const {
+        return {target_array.data() + offset_array[vertex], degree(vertex)};
+    }
+
+    /**
+     * @brief Get the weights of the arcs leaving a vertex
+     * @param vertex The vertex ID
+     * @return A view aligned with neighbors(vertex), or an empty view for an unweighted graph
+     */
+    std::span<const int> neighbor_weights(uint32_t vertex) const {
+        if (weight_array.empty()) {
+            return {};
+        }
+        return {weight_array.data() + offset_array[vertex], degree(vertex)};
+    }
+
+    /**
+     * @brief Call f(neighbor, weight) for every arc leaving a vertex, in ascending neighbor order
+     * @param vertex The vertex ID
+     * @param f The callback; if it returns bool, returning false stops the scan
+     * @return false if the callback stopped the scan, true otherwise
+     */
+    template<typename F>
+    bool for_each_neighbor(uint32_t vertex, F&& f) const {
+        const uint32_t* target = target_array.data();
+        for (uint64_t arc = offset_array[vertex]; arc < offset_array[vertex + 1]; ++arc) {
+            if (!csr_detail::visit_neighbor(f, target[arc], weight(arc))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Start a resumable scan of the neighbors of a vertex
+     * @param vertex The vertex ID
+     * @return A cursor over the neighbors in ascending order
+     */
+    CSRNeighborCursor cursor(uint32_t vertex) const {
+        return CSRNeighborCursor(target_array.data() + offset_array[vertex],
+                                 target_array.data() + offset_array[vertex + 1],
+                                 weight_array.empty() ? nullptr : weight_array.data() + offset_array[vertex]);
+    }
+
+    /**
+     * @brief Get the weight of an arc by its position in the target array
+     * @param arc The arc index, in [offsets()[v], offsets()[v + 1]) for its source v
+     * @return The weight of the arc
+     */
+    int weight(uint64_t arc) const {
+        return weight_array.empty() ? 1 : weight_array[arc];
+    }
+
+    /**
+     * @brief Check if an arc exists between two vertices
+     * @param from The source vertex ID
+     * @param to The target vertex ID
+     * @return true if the arc exists, false otherwise
+     */
+    bool has_edge(uint32_t from, uint32_t to) const {
+        auto list = neighbors(from);
+        return std::binary_search(list.begin(), list.end(), to);
+    }
+
+    /**
+     * @brief Build the graph with every arc reversed
+     * @return The transposed graph (a copy of this graph if it is undirected)
+     */
+    CSRGraph transpose() const {
+        if (!directed) {
+            return *this;
+        }
+
+        size_t n = vertex_count();
+        std::vector<uint64_t> offsets(n + 1, 0);
+        for (uint32_t target : target_array) {
+            offsets[target + 1]++;
+        }
+        for (size_t v = 0; v < n; ++v) {
+            offsets[v + 1] += offsets[v];
+        }
+
+        // Visiting sources in ascending order keeps every reversed list sorted
+        std::vector<uint64_t> cursor(offsets.begin(), offsets.end() - 1);
+        std::vector<uint32_t> targets(target_array.size());
+        std::vector<int> weights(weight_array.size());
+        for (uint32_t u = 0; u < n; ++u) {
+            for (uint64_t arc = offset_array[u]; arc < offset_array[u + 1]; ++arc) {
+                uint64_t slot = cursor[target_array[arc]]++;
+                targets[slot] = u;
+                if (!weights.empty()) {
+                    weights[slot] = weight_array[arc];
+                }
+            }
+        }
+        return CSRGraph(std::move(offsets), std::move(targets), std::move(weights), true);
+    }
+
+    /**
+     * @brief Get the raw offset array (V + 1 entries)
+     */
+    const std::vector<uint64_t>& offsets() const {
+        return offset_array;
+    }
+
+    /**
+     * @brief Get the raw target array (one entry per arc)
+     */
+    const std::vector<uint32_t>& targets() const {
+        return target_array;
+    }
+
+    /**
+     * @brief Get the raw weight array (empty for an unweighted graph)
+     */
+    const std::vector<int>& weights() const {
+        return weight_array;
+    }
+
+    /**
+     * @brief Estimate the memory held by the graph
+     * @return The number of bytes used by the CSR arrays
+     */
+    size_t memory_bytes() const {
+        return offset_array.capacity() * sizeof(uint64_t) + target_array.capacity() * sizeof(uint32_t) +
+               weight_array.capacity() * sizeof(int);
+    }
+};
+
+/**
+ * @class GraphSnapshot
+ * @brief An immutable CSR copy of a Graph<T> together with the mapping between keys and dense IDs
+ */
+template<typename T>
+class GraphSnapshot {
+private:
+    CSRGraph graph;
+    std::vector<T> keys;
+    std::unordered_map<T, uint32_t> ids;
+
+public:
+    /**
+     * @brief Construct a snapshot from a CSR graph and the key of every vertex ID
+     * @param graph The CSR graph
+     * @param keys keys[id] is the original key of vertex id
+     */
+    GraphSnapshot(CSRGraph graph, std::vector<T> keys) : graph(std::move(graph)), keys(std::move(keys)) {
+        ids.reserve(this->keys.size());
+        for (uint32_t id = 0; id < this->keys.size(); ++id) {
+            ids.emplace(this->keys[id], id);
+        }
+    }
+
+    /**
+     * @brief Construct a snapshot when the key to ID map has already been built
+     * @param graph The CSR graph
+     * @param keys keys[id] is the original key of vertex id
+     * @param ids The inverse of keys
+     */
+    GraphSnapshot(CSRGraph graph, std::vector<T> keys, std::unordered_map<T, uint32_t> ids)
+        : graph(std::move(graph)), keys(std::move(keys)), ids(std::move(ids)) {}
+
+    /**
+     * @brief Get the CSR graph the analytics run on
+     */
+    const CSRGraph& csr() const {
+        return graph;
+    }
+
+    /**
+     * @brief Get the number of vertices
+     */
+    size_t vertex_count() const {
+        return keys.size();
+    }
+
+    /**
+     * @brief Check if a key is a vertex of the snapshot
+     * @param key The vertex key
+     * @return true if the key has an ID, false otherwise
+     */
+    bool contains(const T& key) const {
+        return ids.find(key) != ids.end();
+    }
+
+    /**
+     * @brief Get the dense ID of a vertex
+     * @param key The vertex key
+     * @return The vertex ID
+     * @throw std::out_of_range if the key is not a vertex of the snapshot
+     */
+    uint32_t id_of(const T& key) const {
+        auto it = ids.find(key);
+        if (it == ids.end()) {
+            throw std::out_of_range("Vertex is not in the snapshot");
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Get the key of a vertex ID
+     * @param id The vertex ID
+     * @return The original vertex key
+     */
+    const T& key_of(uint32_t id) const {
+        return keys[id];
+    }
+
+    /**
+     * @brief Get all keys indexed by vertex ID
+     */
+    const std::vector<T>& vertex_keys() const {
+        return keys;
+    }
+
+    /**
+     * @brief Get the neighbors of a vertex without copying
+     * @param key The vertex key
+     * @return A view of the neighbor IDs in ascending order
+     * @throw std::out_of_range if the key is not a vertex of the snapshot
+     */
+    std::span<const uint32_t> neighbors(const T& key) const {
+        return graph.neighbors(id_of(key));
+    }
+};
+
+#endif // CSR_GRAPH_HPP
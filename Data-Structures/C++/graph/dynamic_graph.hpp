@@ -0,0 +1,487 @@
+/**
+ * @file dynamic_graph.hpp
+ * @brief Streaming graph store: batched edge updates, snapshot-isolated readers, compaction to CSR
+ *
+ * The graph is an immutable CSR base plus an overlay of per-vertex adjacency blocks for
+ * the vertices changed since the base was built. The overlay is a two-level table: the
+ * top level points at chunks of CHUNK_SIZE block pointers, and a null block means "use
+ * the base list". Blocks and chunks are never modified after they are published.
+ *
+ * apply() turns a batch of inserts and deletes into a new version (copy-on-write):
+ * - rebuild the sorted list of every touched vertex into a fresh block, in parallel;
+ * - copy only the chunks that contain touched vertices;
+ * - copy the top-level table of chunk pointers;
+ * - publish the result with one atomic pointer store.
+ * Writers are serialized by a mutex. Readers never take it. snapshot() atomically loads
+ * the current version, and the version, with everything it references, stays alive and
+ * unchanged for as long as the snapshot is held, while newer batches are published
+ * concurrently.
+ *
+ * compact() builds a fresh CSR base from a snapshot without holding the writer lock,
+ * then publishes it together with whatever overlay blocks were written in the meantime
+ * (blocks are immutable, so "changed since the snapshot" is a pointer comparison).
+ * apply() also compacts by itself once the overlay covers more than compaction_ratio
+ * of the vertices. One compaction runs at a time: a writer that crosses the threshold
+ * while another compaction is in progress leaves it to that one, and a base built
+ * from a version whose base has since been replaced is discarded.
+ *
+ * Edges have set semantics: at most one arc per (source, target). Inserting an existing
+ * arc updates its weight, and deleting a missing arc is a no-op. Within a batch, later
+ * updates of the same arc win. Undirected graphs apply every update to both directions.
+ * Vertex IDs grow as needed.
+ *
+ * Time Complexity:
+ * - apply(): O(b log b + sum of the degrees of touched vertices + touched chunks * CHUNK_SIZE
+ *   + V / CHUNK_SIZE) for a batch of b updates
+ * - snapshot(): O(1); neighbors() / degree(): O(1); has_edge(): O(log d)
+ * - compact(): O(V + E)
+ *
+ * Space Complexity: O(V + E) per live version, shared between versions wherever unchanged
+ */
+
+#ifndef DYNAMIC_GRAPH_HPP
+#define DYNAMIC_GRAPH_HPP
+
+#include <span>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include "csr_graph.hpp"
+#include "../other/parallel_for.hpp"
+
+/**
+ * @brief One edge insertion or deletion
+ */
+struct EdgeUpdate {
+    uint32_t source;
+    uint32_t target;
+    int weight = 1;         // Ignored by deletions and by unweighted graphs
+    bool insert = true;     // false deletes the edge
+};
+
+/**
+ * @brief Options for DynamicGraph
+ */
+struct DynamicGraphOptions {
+    bool directed = true;           // Ignored when starting from a CSR base, which decides it
+    bool weighted = false;          // Store weights (also forced on by a weighted base)
+    double compaction_ratio = 0.25; // Compact once this fraction of vertices has overlay blocks (0 disables)
+    size_t threads = 0;             // Worker threads (0 means default_thread_count())
+};
+
+namespace dynamic_graph_detail {
+
+inline constexpr size_t CHUNK_BITS = 10;
+inline constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;
+
+struct Block {
+    std::vector<uint32_t> targets;  // Sorted
+    std::vector<int> weights;       // Aligned with targets; empty for an unweighted graph
+};
+
+using BlockPtr = std::shared_ptr<const Block>;
+
+struct Chunk {
+    std::array<BlockPtr, CHUNK_SIZE> blocks;
+};
+
+using ChunkPtr = std::shared_ptr<const Chunk>;
+
+struct Version {
+    uint64_t number = 0;
+    std::shared_ptr<const CSRGraph> base;
+    std::vector<ChunkPtr> chunks;       // Null chunk: every vertex in it uses the base
+    size_t vertex_count = 0;
+    uint64_t arc_count = 0;
+    size_t overlay_vertices = 0;
+    bool directed = true;
+    bool weighted = false;
+
+    const Block* block(uint32_t v) const {
+        const ChunkPtr& chunk = chunks[v >> CHUNK_BITS];
+        return chunk ? chunk->blocks[v & (CHUNK_SIZE - 1)].get() : nullptr;
+    }
+
+    std::span<const uint32_t> neighbors(uint32_t v) const {
+        if (const Block* b = block(v)) {
+            return b->targets;
+        }
+        return v < base->vertex_count() ? base->neighbors(v) : std::span<const uint32_t>();
+    }
+
+    std::span<const int> weights(uint32_t v) const {
+        if (const Block* b = block(v)) {
+            return b->weights;
+        }
+        return v < base->vertex_count() ? base->neighbor_weights(v) : std::span<const int>();
+    }
+};
+
+} // namespace dynamic_graph_detail
+
+/**
+ * @class DynamicGraphSnapshot
+ * @brief A consistent, immutable view of a DynamicGraph at one version
+ */
+class DynamicGraphSnapshot {
+private:
+    std::shared_ptr<const dynamic_graph_detail::Version> state;
+
+public:
+    explicit DynamicGraphSnapshot(std::shared_ptr<const dynamic_graph_detail::Version> state)
+        : state(std::move(state)) {}
+
+    /**
+     * @brief Get the version number (incremented by every batch and compaction)
+     */
+    uint64_t version() const {
+        return state->number;
+    }
+
+    size_t vertex_count() const {
+        return state->vertex_count;
+    }
+
+    uint64_t arc_count() const {
+        return state->arc_count;
+    }
+
+    bool is_directed() const {
+        return state->directed;
+    }
+
+    bool is_weighted() const {
+        return state->weighted;
+    }
+
+    size_t degree(uint32_t vertex) const {
+        return state->neighbors(vertex).size();
+    }
+
+    /**
+     * @brief Get the neighbors of a vertex; the view is valid as long as the snapshot
+     * @param vertex The vertex ID
+     * @return A view of the neighbor IDs in ascending order
+     */
+    std::span<const uint32_t> neighbors(uint32_t vertex) const {
+        return state->neighbors(vertex);
+    }
+
+    /**
+     * @brief Get the weights of the arcs leaving a vertex
+     * @param vertex The vertex ID
+     * @return A view aligned with neighbors(vertex), or an empty view for an unweighted graph
+     */
+    std::span<const int> neighbor_weights(uint32_t vertex) const {
+        return state->weights(vertex);
+    }
+
+    bool has_edge(uint32_t from, uint32_t to) const {
+        auto list = neighbors(from);
+        return std::binary_search(list.begin(), list.end(), to);
+    }
+
+    /**
+     * @brief Get the number of vertices whose lists live in overlay blocks rather than the base
+     */
+    size_t overlay_vertex_count() const {
+        return state->overlay_vertices;
+    }
+
+    /**
+     * @brief Materialize the snapshot as a CSR graph
+     * @param threads Worker threads (0 means default_thread_count())
+     * @return The graph, with the same neighbor order
+     */
+    CSRGraph to_csr(size_t threads = 0) const {
+        size_t n = vertex_count();
+        std::vector<uint64_t> offsets(n + 1, 0);
+        for (uint32_t v = 0; v < n; ++v) {
+            offsets[v + 1] = offsets[v] + degree(v);
+        }
+        std::vector<uint32_t> targets(offsets.back());
+        std::vector<int> weights(is_weighted() ? offsets.back() : 0);
+        parallel_for(0, n, [&](size_t v) {
+            auto list = neighbors(static_cast<uint32_t>(v));
+            std::copy(list.begin(), list.end(), targets.begin() + static_cast<std::ptrdiff_t>(offsets[v]));
+            if (is_weighted()) {
+                auto w = neighbor_weights(static_cast<uint32_t>(v));
+                std::copy(w.begin(), w.end(), weights.begin() + static_cast<std::ptrdiff_t>(offsets[v]));
+            }
+        }, 1024, threads);
+        return CSRGraph(std::move(offsets), std::move(targets), std::move(weights), is_directed());
+    }
+};
+
+/**
+ * @class DynamicGraph
+ * @brief Versioned graph store with one writer at a time and any number of lock-free readers
+ */
+class DynamicGraph {
+private:
+    using Version = dynamic_graph_detail::Version;
+
+    DynamicGraphOptions options;
+    std::atomic<std::shared_ptr<const Version>> current;
+    std::mutex writer;
+    std::mutex compactor;   // Held for the whole of a compaction
+
+    std::shared_ptr<const Version> load() const {
+        return current.load(std::memory_order_acquire);
+    }
+
+    // Merge the sorted updates of one vertex (target order, batch order within a target) into its list
+    static dynamic_graph_detail::BlockPtr rebuild(const Version& version, uint32_t v, const EdgeUpdate* first,
+                                                  const EdgeUpdate* last, bool weighted) {
+        auto old_targets = v < version.vertex_count ? version.neighbors(v) : std::span<const uint32_t>();
+        auto old_weights = v < version.vertex_count ? version.weights(v) : std::span<const int>();
+        auto block = std::make_shared<dynamic_graph_detail::Block>();
+        block->targets.reserve(old_targets.size() + static_cast<size_t>(last - first));
+        auto emit = [&](uint32_t target, int weight) {
+            // Collapse parallel arcs inherited from the base
+            if (!block->targets.empty() && block->targets.back() == target) {
+                return;
+            }
+            block->targets.push_back(target);
+            if (weighted) {
+                block->weights.push_back(weight);
+            }
+        };
+        size_t i = 0;
+        while (i < old_targets.size() || first != last) {
+            if (first == last || (i < old_targets.size() && old_targets[i] < first->target)) {
+                emit(old_targets[i], old_weights.empty() ? 1 : old_weights[i]);
+                ++i;
+                continue;
+            }
+            uint32_t target = first->target;
+            const EdgeUpdate* final_update = first;
+            while (first != last && first->target == target) {
+                final_update = first++;
+            }
+            while (i < old_targets.size() && old_targets[i] == target) {
+                ++i;
+            }
+            if (final_update->insert) {
+                emit(target, final_update->weight);
+            }
+        }
+        return block;
+    }
+
+    // Replace the base by a CSR built from `from`, keeping blocks written after it.
+    // The caller holds compactor. Returns false if the base changed since `from`.
+    bool rebase(const std::shared_ptr<const Version>& from) {
+        auto base = std::make_shared<const CSRGraph>(DynamicGraphSnapshot(from).to_csr(options.threads));
+        std::lock_guard<std::mutex> lock(writer);
+        std::shared_ptr<const Version> latest = load();
+        if (latest->base != from->base) {
+            // Blocks are only diffed against the base they were written over
+            return false;
+        }
+        auto next = std::make_shared<Version>(*latest);
+        next->number = latest->number + 1;
+        next->base = std::move(base);
+        next->overlay_vertices = 0;
+        for (size_t c = 0; c < next->chunks.size(); ++c) {
+            const auto& chunk = latest->chunks[c];
+            const auto* before = c < from->chunks.size() ? from->chunks[c].get() : nullptr;
+            if (!chunk || chunk.get() == before) {
+                next->chunks[c] = nullptr;
+                continue;
+            }
+            auto kept = std::make_shared<dynamic_graph_detail::Chunk>();
+            size_t count = 0;
+            for (size_t i = 0; i < dynamic_graph_detail::CHUNK_SIZE; ++i) {
+                const auto& block = chunk->blocks[i];
+                uint32_t v = static_cast<uint32_t>((c << dynamic_graph_detail::CHUNK_BITS) + i);
+                bool same = before != nullptr && before->blocks[i] == block;
+                if (block && (!same || v >= from->vertex_count)) {
+                    kept->blocks[i] = block;
+                    count++;
+                }
+            }
+            next->chunks[c] = count > 0 ? std::move(kept) : nullptr;
+            next->overlay_vertices += count;
+        }
+        // Vertices added after `from` have no base list yet; their blocks were kept above
+        current.store(std::move(next), std::memory_order_release);
+        return true;
+    }
+
+public:
+    /**
+     * @brief Create an empty graph
+     * @param options Direction, weights, compaction and threads
+     */
+    explicit DynamicGraph(const DynamicGraphOptions& options = {}) : options(options) {
+        auto version = std::make_shared<Version>();
+        version->base = std::make_shared<const CSRGraph>(std::vector<uint64_t>{0}, std::vector<uint32_t>{},
+                                                         std::vector<int>{}, options.directed);
+        version->directed = options.directed;
+        version->weighted = options.weighted;
+        current.store(std::move(version));
+    }
+
+    /**
+     * @brief Start from an existing CSR graph (its direction and weights are kept)
+     * @param base The initial graph; neighbor lists must be sorted
+     * @param options Weights, compaction and threads
+     */
+    explicit DynamicGraph(CSRGraph base, const DynamicGraphOptions& options = {}) : options(options) {
+        auto version = std::make_shared<Version>();
+        version->directed = base.is_directed();
+        version->weighted = options.weighted || base.is_weighted();
+        if (version->weighted && !base.is_weighted()) {
+            base = CSRGraph(base.offsets(), base.targets(), std::vector<int>(base.arc_count(), 1), base.is_directed());
+        }
+        version->vertex_count = base.vertex_count();
+        version->arc_count = base.arc_count();
+        version->chunks.resize((version->vertex_count + dynamic_graph_detail::CHUNK_SIZE - 1) >>
+                               dynamic_graph_detail::CHUNK_BITS);
+        version->base = std::make_shared<const CSRGraph>(std::move(base));
+        this->options.directed = version->directed;
+        current.store(std::move(version));
+    }
+
+    DynamicGraph(const DynamicGraph&) = delete;
+    DynamicGraph& operator=(const DynamicGraph&) = delete;
+
+    /**
+     * @brief Get a consistent view of the latest version; never blocks on writers
+     */
+    DynamicGraphSnapshot snapshot() const {
+        return DynamicGraphSnapshot(load());
+    }
+
+    /**
+     * @brief Get the latest version number
+     */
+    uint64_t version() const {
+        return load()->number;
+    }
+
+    /**
+     * @brief Apply a batch of edge updates atomically
+     * @param batch The updates, applied in order
+     * @return The version number that contains the batch
+     */
+    uint64_t apply(std::vector<EdgeUpdate> batch) {
+        using namespace dynamic_graph_detail;
+        std::unique_lock<std::mutex> lock(writer);
+        std::shared_ptr<const Version> previous = load();
+        if (!previous->directed) {
+            // Each mirror directly follows its update, so both directions keep the batch order
+            std::vector<EdgeUpdate> both;
+            both.reserve(batch.size() * 2);
+            for (const EdgeUpdate& update : batch) {
+                both.push_back(update);
+                if (update.source != update.target) {
+                    both.push_back({update.target, update.source, update.weight, update.insert});
+                }
+            }
+            batch = std::move(both);
+        }
+        // Stable: updates of the same arc keep their batch order, so the last one wins
+        std::stable_sort(batch.begin(), batch.end(), [](const EdgeUpdate& a, const EdgeUpdate& b) {
+            return a.source != b.source ? a.source < b.source : a.target < b.target;
+        });
+
+        auto next = std::make_shared<Version>(*previous);
+        next->number = previous->number + 1;
+        for (const EdgeUpdate& update : batch) {
+            next->vertex_count = std::max<size_t>(next->vertex_count, size_t(std::max(update.source, update.target)) + 1);
+        }
+        next->chunks.resize((next->vertex_count + CHUNK_SIZE - 1) >> CHUNK_BITS);
+
+        std::vector<size_t> starts;     // Index of the first update of every touched vertex
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (i == 0 || batch[i].source != batch[i - 1].source) {
+                starts.push_back(i);
+            }
+        }
+        starts.push_back(batch.size());
+        size_t touched = starts.size() - 1;
+        std::vector<BlockPtr> blocks(touched);
+        parallel_for(0, touched, [&](size_t t) {
+            blocks[t] = rebuild(*previous, batch[starts[t]].source, batch.data() + starts[t],
+                                batch.data() + starts[t + 1], next->weighted);
+        }, 64, options.threads);
+
+        std::shared_ptr<Chunk> open;
+        size_t open_index = 0;
+        for (size_t t = 0; t < touched; ++t) {
+            uint32_t v = batch[starts[t]].source;
+            size_t c = v >> CHUNK_BITS;
+            if (!open || open_index != c) {
+                if (open) {
+                    next->chunks[open_index] = std::move(open);
+                }
+                open = next->chunks[c] ? std::make_shared<Chunk>(*next->chunks[c]) : std::make_shared<Chunk>();
+                open_index = c;
+            }
+            BlockPtr& slot = open->blocks[v & (CHUNK_SIZE - 1)];
+            next->overlay_vertices += slot ? 0 : 1;
+            next->arc_count -= v < previous->vertex_count ? previous->neighbors(v).size() : 0;
+            next->arc_count += blocks[t]->targets.size();
+            slot = std::move(blocks[t]);
+        }
+        if (open) {
+            next->chunks[open_index] = std::move(open);
+        }
+
+        uint64_t number = next->number;
+        bool compact_now = options.compaction_ratio > 0.0 &&
+                           static_cast<double>(next->overlay_vertices) >
+                               options.compaction_ratio * static_cast<double>(next->vertex_count);
+        std::shared_ptr<const Version> published = std::move(next);
+        current.store(published, std::memory_order_release);
+        if (compact_now) {
+            lock.unlock();
+            std::unique_lock<std::mutex> compacting(compactor, std::try_to_lock);
+            if (compacting.owns_lock()) {
+                rebase(load());
+                return load()->number;
+            }
+        }
+        return number;
+    }
+
+    /**
+     * @brief Insert an edge (or update its weight) as a batch of one
+     * @return The new version number
+     */
+    uint64_t insert_edge(uint32_t source, uint32_t target, int weight = 1) {
+        return apply({{source, target, weight, true}});
+    }
+
+    /**
+     * @brief Remove an edge as a batch of one
+     * @return The new version number
+     */
+    uint64_t remove_edge(uint32_t source, uint32_t target) {
+        return apply({{source, target, 1, false}});
+    }
+
+    /**
+     * @brief Rebuild the CSR base from the latest version and drop the overlay
+     *
+     * Writers may continue while the new base is built; their blocks are carried over.
+     *
+     * @return The version number of the compacted graph
+     */
+    uint64_t compact() {
+        std::lock_guard<std::mutex> compacting(compactor);
+        rebase(load());
+        return version();
+    }
+};
+
+#endif // DYNAMIC_GRAPH_HPP
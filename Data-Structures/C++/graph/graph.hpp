@@ -15,8 +15,20 @@
  * - Get neighbors: O(1)
  * - BFS: O(V + E)
  * - DFS: O(V + E)
+ * - Connectivity / components: O((V + E) α(V)), or O(α(V)) per query with
+ *   enable_incremental_connectivity()
+ * - Freeze to CSR: O(V log V + E log d)
+ * - Strongly connected components / topological sort / cycle check: O(V log V + E log d),
+ *   dominated by the freeze
+ * - Betweenness centrality: O(V (V + E)) unweighted, O(V (V + E) log V) weighted
  * 
  * Space Complexity: O(V + E)
+ *
+ * For read-mostly workloads, freeze() produces a compact CSR snapshot (csr_graph.hpp)
+ * with dense 32-bit vertex IDs on which the analytics in this directory operate.
+ * Traversals that only need aggregates or a bounded neighborhood should use the
+ * visitor-based breadth_first_visit()/depth_first_visit() (traversal.hpp) on the
+ * snapshot instead of bfs()/dfs(), which materialize every visited vertex.
  */
 
 #ifndef GRAPH_HPP
@@ -28,6 +40,16 @@
 #include <queue>
 #include <stack>
 #include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <tuple>
+
+#include "csr_graph.hpp"
+#include "strong_components.hpp"
+#include "topological_sort.hpp"
+#include "centrality.hpp"
+#include "../other/disjoint_set.hpp"
 
 template<typename T>
 class Graph {
@@ -35,6 +57,48 @@ private:
     std::unordered_map<T, std::unordered_map<T, int>> adjacency_list;
     bool directed;
 
+    // Incremental connectivity: a union-find over the vertices kept up to date by
+    // add_vertex/add_edge. Removals only mark it stale; the next query rebuilds it.
+    bool incremental = false;
+    mutable bool connectivity_stale = false;
+    mutable DisjointSet connectivity;
+    mutable std::unordered_map<T, uint32_t> connectivity_ids;
+
+    void refresh_connectivity() const {
+        if (connectivity_stale) {
+            connectivity_ids.clear();
+            connectivity = build_components(connectivity_ids);
+            connectivity_stale = false;
+        }
+    }
+
+    void track_vertex(const T& vertex) {
+        if (incremental && !connectivity_stale) {
+            connectivity_ids.emplace(vertex, connectivity.add());
+        }
+    }
+
+    /**
+     * @brief Union the endpoints of every edge, without recursion
+     * @param ids Filled with a dense ID for every vertex
+     * @return The disjoint sets of the vertex IDs
+     */
+    DisjointSet build_components(std::unordered_map<T, uint32_t>& ids) const {
+        ids.reserve(adjacency_list.size());
+        for (const auto& [vertex, _] : adjacency_list) {
+            ids.emplace(vertex, static_cast<uint32_t>(ids.size()));
+        }
+
+        DisjointSet sets(ids.size());
+        for (const auto& [vertex, neighbors] : adjacency_list) {
+            uint32_t id = ids.at(vertex);
+            for (const auto& [neighbor, _] : neighbors) {
+                sets.unite(id, ids.at(neighbor));
+            }
+        }
+        return sets;
+    }
+
 public:
     /**
      * @brief Default constructor
@@ -49,6 +113,7 @@ public:
     void add_vertex(const T& vertex) {
         if (adjacency_list.find(vertex) == adjacency_list.end()) {
             adjacency_list[vertex] = std::unordered_map<T, int>();
+            track_vertex(vertex);
         }
     }
 
@@ -66,6 +131,9 @@ public:
         if (!directed) {
             adjacency_list[vertex2][vertex1] = weight;
         }
+        if (incremental && !connectivity_stale) {
+            connectivity.unite(connectivity_ids.at(vertex1), connectivity_ids.at(vertex2));
+        }
     }
 
     /**
@@ -85,6 +153,7 @@ public:
 
         // Remove the vertex
         adjacency_list.erase(vertex);
+        connectivity_stale = incremental;
         return true;
     }
 
@@ -108,6 +177,7 @@ public:
         if (!directed) {
             adjacency_list[vertex2].erase(vertex1);
         }
+        connectivity_stale = incremental;
         return true;
     }
 
@@ -208,81 +278,283 @@ public:
             return {};
         }
 
+        using NeighborIterator = typename std::unordered_map<T, int>::const_iterator;
+
         std::unordered_set<T> visited;
         std::vector<T> result;
+        // Explicit stack of (next neighbor, end) cursors: same preorder as the recursive
+        // formulation, but the depth is not limited by the call stack
+        std::vector<std::pair<NeighborIterator, NeighborIterator>> stack;
 
-        std::function<void(const T&)> dfs_recursive = [&](const T& vertex) {
+        auto enter = [&](const T& vertex) {
             visited.insert(vertex);
             result.push_back(vertex);
-
-            for (const auto& [neighbor, _] : adjacency_list.at(vertex)) {
-                if (visited.find(neighbor) == visited.end()) {
-                    dfs_recursive(neighbor);
-                }
-            }
+            const auto& neighbors = adjacency_list.at(vertex);
+            stack.emplace_back(neighbors.begin(), neighbors.end());
         };
 
-        dfs_recursive(start_vertex);
+        enter(start_vertex);
+        while (!stack.empty()) {
+            auto& [next, end] = stack.back();
+            if (next == end) {
+                stack.pop_back();
+                continue;
+            }
+            const T& neighbor = (next++)->first;
+            if (visited.find(neighbor) == visited.end()) {
+                enter(neighbor);
+            }
+        }
         return result;
     }
 
     /**
      * @brief Check if the graph is connected
-     * @return true if the graph is connected, false otherwise
+     * @return true if the graph is connected (weakly, for a directed graph), false otherwise
      */
     bool is_connected() const {
-        if (adjacency_list.empty()) {
-            return true;
+        if (incremental) {
+            refresh_connectivity();
+            return connectivity.set_count() <= 1;
         }
-
-        T start_vertex = adjacency_list.begin()->first;
-        std::unordered_set<T> visited;
-
-        std::function<void(const T&)> dfs = [&](const T& vertex) {
-            visited.insert(vertex);
-            for (const auto& [neighbor, _] : adjacency_list.at(vertex)) {
-                if (visited.find(neighbor) == visited.end()) {
-                    dfs(neighbor);
-                }
-            }
-        };
-
-        dfs(start_vertex);
-        return visited.size() == adjacency_list.size();
+        std::unordered_map<T, uint32_t> ids;
+        return build_components(ids).set_count() <= 1;
     }
 
     /**
      * @brief Get all connected components in the graph
-     * @return A vector of sets, where each set contains the vertices in a connected component
+     * @return A vector of sets, where each set contains the vertices in a connected
+     *         (weakly, for a directed graph) component
      */
     std::vector<std::unordered_set<T>> get_connected_components() const {
-        if (adjacency_list.empty()) {
-            return {};
+        std::unordered_map<T, uint32_t> local_ids;
+        DisjointSet local_sets;
+        if (incremental) {
+            refresh_connectivity();
+        } else {
+            local_sets = build_components(local_ids);
         }
+        const auto& ids = incremental ? connectivity_ids : local_ids;
+        DisjointSet& sets = incremental ? connectivity : local_sets;
 
-        std::unordered_set<T> visited;
         std::vector<std::unordered_set<T>> components;
+        std::unordered_map<uint32_t, size_t> component_of_root;
+        for (const auto& [vertex, id] : ids) {
+            auto [it, inserted] = component_of_root.emplace(sets.find(id), components.size());
+            if (inserted) {
+                components.emplace_back();
+            }
+            components[it->second].insert(vertex);
+        }
+        return components;
+    }
 
-        std::function<void(const T&, std::unordered_set<T>&)> dfs = [&](const T& vertex, std::unordered_set<T>& component) {
-            visited.insert(vertex);
-            component.insert(vertex);
+    /**
+     * @brief Get the strongly connected components of the graph, without recursion
+     * @return The components in topological order: no edge leads from a later
+     *         component to an earlier one (for an undirected graph, the connected components)
+     */
+    std::vector<std::vector<T>> get_strongly_connected_components() const {
+        GraphSnapshot<T> snapshot = freeze();
+        SCCResult scc = strongly_connected_components(snapshot.csr());
+        std::vector<std::vector<T>> components(scc.count());
+        for (uint32_t id = 0; id < snapshot.vertex_count(); ++id) {
+            components[scc.label[id]].push_back(snapshot.key_of(id));
+        }
+        return components;
+    }
 
-            for (const auto& [neighbor, _] : adjacency_list.at(vertex)) {
-                if (visited.find(neighbor) == visited.end()) {
-                    dfs(neighbor, component);
-                }
+    /**
+     * @brief Check if the graph contains a cycle
+     * @return true if there is a directed cycle (for an undirected graph: an edge closing
+     *         a cycle, including self-loops), false otherwise
+     */
+    bool has_cycle() const {
+        if (directed) {
+            return !find_cycle(freeze().csr()).empty();
+        }
+        std::unordered_map<T, uint32_t> ids;
+        ids.reserve(adjacency_list.size());
+        for (const auto& [vertex, _] : adjacency_list) {
+            ids.emplace(vertex, static_cast<uint32_t>(ids.size()));
+        }
+        DisjointSet sets(ids.size());
+        for (const auto& [vertex1, vertex2, _] : get_edges()) {
+            if (!sets.unite(ids.at(vertex1), ids.at(vertex2))) {
+                return true;
             }
-        };
+        }
+        // get_edges() reports each undirected edge once, from its smaller endpoint, so a
+        // self-loop is only visible in the adjacency list
+        for (const auto& [vertex, neighbors] : adjacency_list) {
+            if (neighbors.find(vertex) != neighbors.end()) {
+                return true;
+            }
+        }
+        return false;
+    }
 
-        for (const auto& [vertex, _] : adjacency_list) {
-            if (visited.find(vertex) == visited.end()) {
-                std::unordered_set<T> component;
-                dfs(vertex, component);
-                components.push_back(component);
+    /**
+     * @brief Order the vertices so that every edge leads from an earlier to a later vertex
+     * @return The vertices in topological order (Kahn's algorithm with a min-heap, so every
+     *         tie goes to the smallest key)
+     * @throw std::invalid_argument if the graph is undirected
+     * @throw std::runtime_error if the graph contains a cycle
+     */
+    std::vector<T> topological_sort() const {
+        if (!directed) {
+            throw std::invalid_argument("Topological ordering requires a directed graph");
+        }
+        // freeze() numbers the vertices in key order, so the smallest ID is the smallest key
+        GraphSnapshot<T> snapshot = freeze();
+        std::vector<T> order;
+        order.reserve(snapshot.vertex_count());
+        for (uint32_t id : lexicographic_topological_sort(snapshot.csr())) {
+            order.push_back(snapshot.key_of(id));
+        }
+        return order;
+    }
+
+    /**
+     * @brief Get the betweenness centrality of every vertex (Brandes' algorithm on a frozen snapshot)
+     * @param options Threads, weighting, normalization and sampling (see centrality.hpp)
+     * @return The score of every vertex
+     * @throw std::invalid_argument if an edge weight is not positive
+     */
+    std::unordered_map<T, double> get_betweenness_centrality(const CentralityOptions& options = {}) const {
+        GraphSnapshot<T> snapshot = freeze();
+        CentralityResult result = betweenness_centrality(snapshot.csr(), options);
+        std::unordered_map<T, double> scores;
+        scores.reserve(snapshot.vertex_count());
+        for (uint32_t id = 0; id < snapshot.vertex_count(); ++id) {
+            scores.emplace(snapshot.key_of(id), result.score[id]);
+        }
+        return scores;
+    }
+
+    /**
+     * @brief Maintain connectivity incrementally from now on
+     *
+     * add_vertex() and add_edge() then update a union-find, which turns is_connected(),
+     * connected() and the component queries into near-constant-time lookups.
+     * remove_vertex() and remove_edge() invalidate it lazily: the first query after a
+     * batch of removals rebuilds it once in O(V + E). Queries are not safe to run
+     * concurrently with each other, since they compress union-find paths.
+     */
+    void enable_incremental_connectivity() {
+        incremental = true;
+        connectivity_stale = true;
+        refresh_connectivity();
+    }
+
+    /**
+     * @brief Stop maintaining connectivity incrementally and release its memory
+     */
+    void disable_incremental_connectivity() {
+        incremental = false;
+        connectivity_stale = false;
+        connectivity = DisjointSet();
+        connectivity_ids.clear();
+    }
+
+    /**
+     * @brief Check if two vertices are in the same (weakly) connected component
+     * @param vertex1 The first vertex
+     * @param vertex2 The second vertex
+     * @return true if both vertices exist and are connected, false otherwise
+     */
+    bool connected(const T& vertex1, const T& vertex2) const {
+        if (!incremental) {
+            std::unordered_map<T, uint32_t> ids;
+            DisjointSet sets = build_components(ids);
+            auto it1 = ids.find(vertex1);
+            auto it2 = ids.find(vertex2);
+            return it1 != ids.end() && it2 != ids.end() && sets.connected(it1->second, it2->second);
+        }
+        refresh_connectivity();
+        auto it1 = connectivity_ids.find(vertex1);
+        auto it2 = connectivity_ids.find(vertex2);
+        return it1 != connectivity_ids.end() && it2 != connectivity_ids.end() &&
+               connectivity.connected(it1->second, it2->second);
+    }
+
+    /**
+     * @brief Get the number of (weakly) connected components
+     * @return The number of components
+     */
+    size_t component_count() const {
+        if (!incremental) {
+            std::unordered_map<T, uint32_t> ids;
+            return build_components(ids).set_count();
+        }
+        refresh_connectivity();
+        return connectivity.set_count();
+    }
+
+    /**
+     * @brief Get the number of vertices in a vertex's (weakly) connected component
+     * @param vertex The vertex
+     * @return The size of its component, or 0 if the vertex does not exist
+     */
+    size_t component_size(const T& vertex) const {
+        if (!incremental) {
+            std::unordered_map<T, uint32_t> ids;
+            DisjointSet sets = build_components(ids);
+            auto it = ids.find(vertex);
+            return it == ids.end() ? 0 : sets.size_of(it->second);
+        }
+        refresh_connectivity();
+        auto it = connectivity_ids.find(vertex);
+        return it == connectivity_ids.end() ? 0 : connectivity.size_of(it->second);
+    }
+
+    /**
+     * @brief Build an immutable CSR snapshot of the graph
+     * @return The snapshot; vertex IDs are assigned in ascending key order and
+     *         every neighbor list is sorted by ID
+     * @throw std::length_error if the graph has 2^32 or more vertices
+     */
+    GraphSnapshot<T> freeze() const {
+        if (adjacency_list.size() >= std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("Graph is too large for 32-bit vertex IDs");
+        }
+
+        std::vector<T> keys = get_vertices();
+        std::sort(keys.begin(), keys.end());
+
+        std::unordered_map<T, uint32_t> ids;
+        ids.reserve(keys.size());
+        for (uint32_t id = 0; id < keys.size(); ++id) {
+            ids.emplace(keys[id], id);
+        }
+
+        std::vector<uint64_t> offsets(keys.size() + 1, 0);
+        for (uint32_t id = 0; id < keys.size(); ++id) {
+            offsets[id + 1] = offsets[id] + adjacency_list.at(keys[id]).size();
+        }
+
+        std::vector<uint32_t> targets(offsets.back());
+        std::vector<int> weights(offsets.back());
+        std::vector<std::pair<uint32_t, int>> arcs;
+        bool weighted = false;
+        for (uint32_t id = 0; id < keys.size(); ++id) {
+            arcs.clear();
+            for (const auto& [neighbor, weight] : adjacency_list.at(keys[id])) {
+                arcs.emplace_back(ids.at(neighbor), weight);
+                weighted = weighted || weight != 1;
             }
+            std::sort(arcs.begin(), arcs.end());
+            for (size_t i = 0; i < arcs.size(); ++i) {
+                targets[offsets[id] + i] = arcs[i].first;
+                weights[offsets[id] + i] = arcs[i].second;
+            }
+        }
+        if (!weighted) {
+            weights.clear();
         }
 
-        return components;
+        CSRGraph csr(std::move(offsets), std::move(targets), std::move(weights), directed);
+        return GraphSnapshot<T>(std::move(csr), std::move(keys), std::move(ids));
     }
 
     /**
@@ -290,6 +562,7 @@ public:
      */
     void clear() {
         adjacency_list.clear();
+        connectivity_stale = incremental;
     }
 };
 
@@ -0,0 +1,481 @@
+/**
+ * @file graph_benchmark.cpp
+ * @brief Benchmark harness for the graph code: synthetic or real graphs, every major kernel
+ *
+ * Runs BFS (single, 64 times in a row and as one 64-source bit-parallel pass), connected
+ * components, single-source shortest paths, PageRank and triangle counting on the CSR
+ * fast paths and on the hash-map Graph<T> (for graphs up to --hash-limit arcs), and
+ * reports the best time over --repeat runs, edges processed per second and the peak
+ * resident memory of the process so far.
+ *
+ * Usage: graph_benchmark [options]
+ *   --graph rmat|er|grid|road|file  Input graph (default: rmat)
+ *   --scale S                       2^S vertices (default: 18)
+ *   --edge-factor K                 Edges per vertex for rmat and er (default: 16)
+ *   --max-weight W                  Random weights in [1, W] (default: 1; road always weighted)
+ *   --file PATH --format F          Edge list for --graph file; F is snap, mtx, bin or binw
+ *   --directed                      Keep generated or loaded edges one-way
+ *   --seed N --threads T --repeat R
+ *   --hash-limit ARCS               Largest graph to run through Graph<T> (default: 2^22)
+ *   --csv                           Print CSV instead of a table
+ *   --baseline FILE --tolerance X   Compare with an earlier --csv run; exit with status 1
+ *                                   if any kernel got more than X (default 0.2) slower
+ *
+ * Build: g++ -std=c++20 -O2 -pthread graph_benchmark.cpp -o graph_benchmark
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <chrono>
+#include <limits>
+#include <functional>
+#include <unordered_map>
+#include <stdexcept>
+
+#include <sys/resource.h>
+
+#include "graph.hpp"
+#include "graph_generators.hpp"
+#include "graph_loader.hpp"
+#include "traversal.hpp"
+#include "multi_source_bfs.hpp"
+#include "connected_components.hpp"
+#include "shortest_paths.hpp"
+#include "pagerank.hpp"
+#include "triangle_counting.hpp"
+
+struct BenchmarkOptions {
+    std::string graph = "rmat";
+    unsigned scale = 18;
+    size_t edge_factor = 16;
+    int max_weight = 1;
+    std::string file;
+    std::string format = "snap";
+    bool directed = false;
+    uint64_t seed = 1;
+    size_t threads = 0;
+    size_t repeat = 3;
+    size_t hash_limit = size_t(1) << 22;
+    bool csv = false;
+    std::string baseline;
+    double tolerance = 0.2;
+};
+
+struct BenchmarkRow {
+    std::string kernel;
+    std::string form;
+    double seconds;
+    double edges;
+    double peak_mib;
+};
+
+/**
+ * @brief Get the peak resident set size of the process
+ * @return The high-water mark in MiB
+ */
+double peak_memory_mib() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;   // ru_maxrss is in KiB on Linux
+}
+
+/**
+ * @brief Time a kernel, keeping the fastest of several runs
+ * @param repeat Number of runs
+ * @param run The kernel; returns the number of edges it processed
+ * @return (seconds, edges) of the fastest run
+ */
+std::pair<double, double> measure(size_t repeat, const std::function<double()>& run) {
+    double best = std::numeric_limits<double>::infinity();
+    double edges = 0;
+    for (size_t i = 0; i < std::max<size_t>(repeat, 1); ++i) {
+        auto started = std::chrono::steady_clock::now();
+        double processed = run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        if (seconds < best) {
+            best = seconds;
+            edges = processed;
+        }
+    }
+    return {best, edges};
+}
+
+CSRGraph make_graph(const BenchmarkOptions& options) {
+    GeneratorOptions generator;
+    generator.seed = options.seed;
+    generator.max_weight = options.max_weight;
+    generator.undirected = !options.directed;
+    generator.threads = options.threads;
+    size_t side = size_t(1) << (options.scale / 2);
+
+    if (options.graph == "rmat") {
+        return generate_rmat(options.scale, options.edge_factor, generator);
+    }
+    if (options.graph == "er") {
+        size_t n = size_t(1) << options.scale;
+        return generate_erdos_renyi(n, n * options.edge_factor, generator);
+    }
+    if (options.graph == "grid") {
+        return generate_grid(side, side, generator);
+    }
+    if (options.graph == "road") {
+        return generate_road_network(side, side, generator);
+    }
+    if (options.graph == "file") {
+        static const std::unordered_map<std::string, EdgeListFormat> formats = {
+            {"snap", EdgeListFormat::SNAP}, {"mtx", EdgeListFormat::MatrixMarket},
+            {"bin", EdgeListFormat::Binary}, {"binw", EdgeListFormat::BinaryWeighted}};
+        auto format = formats.find(options.format);
+        if (format == formats.end()) {
+            throw std::invalid_argument("Unknown edge list format: " + options.format);
+        }
+        GraphLoadOptions load;
+        load.symmetrize = !options.directed;
+        load.deduplicate = true;
+        load.remove_self_loops = true;
+        load.threads = options.threads;
+        return load_graph(options.file, format->second, load);
+    }
+    throw std::invalid_argument("Unknown graph kind: " + options.graph);
+}
+
+uint32_t highest_degree_vertex(const CSRGraph& graph) {
+    uint32_t best = 0;
+    for (uint32_t v = 1; v < graph.vertex_count(); ++v) {
+        if (graph.degree(v) > graph.degree(best)) {
+            best = v;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Run every kernel on the CSR form
+ */
+void run_csr(const CSRGraph& graph, const BenchmarkOptions& options, std::vector<BenchmarkRow>& rows) {
+    uint32_t source = highest_degree_vertex(graph);
+    auto record = [&](const std::string& kernel, std::pair<double, double> timing) {
+        rows.push_back({kernel, "csr", timing.first, timing.second, peak_memory_mib()});
+    };
+
+    struct ArcCounter : TraversalVisitor {
+        uint64_t arcs = 0;
+        VisitAction examine_edge(uint32_t, uint32_t, uint64_t) {
+            arcs++;
+            return VisitAction::Continue;
+        }
+    };
+    TraversalScratch scratch;
+    record("bfs", measure(options.repeat, [&] {
+        ArcCounter counter;
+        breadth_first_visit(graph, source, counter, scratch);
+        return static_cast<double>(counter.arcs);
+    }));
+
+    // 64 sources spread over the ID range: repeated single BFS against one bit-parallel pass.
+    // Both run on one thread, so the ratio measures only the sharing of the traversal
+    std::vector<uint32_t> sources;
+    for (uint64_t i = 0; i < 64; ++i) {
+        sources.push_back(static_cast<uint32_t>(i * graph.vertex_count() / 64));
+    }
+    record("bfs-64x", measure(options.repeat, [&] {
+        ArcCounter counter;
+        for (uint32_t s : sources) {
+            breadth_first_visit(graph, s, counter, scratch);
+        }
+        return static_cast<double>(counter.arcs);
+    }));
+    record("ms-bfs-64", measure(options.repeat, [&] {
+        // Count the same arcs the single runs examine
+        uint64_t arcs = 0;
+        multi_source_bfs(graph, sources, [&](size_t, uint32_t v, uint32_t) {
+            arcs += graph.degree(v);
+        }, 1);
+        return static_cast<double>(arcs);
+    }));
+
+    ConnectedComponentsOptions components;
+    components.threads = options.threads;
+    record("cc", measure(options.repeat, [&] {
+        connected_components(graph, components);
+        return static_cast<double>(graph.arc_count());
+    }));
+
+    record("sssp-dijkstra", measure(options.repeat, [&] {
+        dijkstra(graph, source);
+        return static_cast<double>(graph.arc_count());
+    }));
+    DeltaSteppingOptions delta;
+    delta.threads = options.threads;
+    record("sssp-delta", measure(options.repeat, [&] {
+        delta_stepping(graph, source, delta);
+        return static_cast<double>(graph.arc_count());
+    }));
+
+    IterationOptions iterations;
+    iterations.max_iterations = 20;
+    iterations.tolerance = 0.0;
+    iterations.threads = options.threads;
+    CSRGraph transposed = graph.is_directed() ? graph.transpose() : CSRGraph();
+    const CSRGraph& in_graph = graph.is_directed() ? transposed : graph;
+    record("pagerank", measure(options.repeat, [&] {
+        return static_cast<double>(pagerank(graph, in_graph, 0.85, iterations).edges_processed);
+    }));
+
+    if (!graph.is_directed()) {
+        record("triangles", measure(options.repeat, [&] {
+            count_triangles(graph, false, options.threads);
+            return static_cast<double>(graph.arc_count());
+        }));
+    }
+}
+
+/**
+ * @brief Run the same kernels through the hash-map Graph<T> interface
+ */
+void run_hash_map(const CSRGraph& csr, const BenchmarkOptions& options, std::vector<BenchmarkRow>& rows) {
+    auto record = [&](const std::string& kernel, std::pair<double, double> timing) {
+        rows.push_back({kernel, "graph", timing.first, timing.second, peak_memory_mib()});
+    };
+    uint32_t source = highest_degree_vertex(csr);
+    double arcs = static_cast<double>(csr.arc_count());
+
+    Graph<uint32_t> graph(csr.is_directed());
+    record("build", measure(1, [&] {
+        for (uint32_t u = 0; u < csr.vertex_count(); ++u) {
+            graph.add_vertex(u);
+            auto neighbors = csr.neighbors(u);
+            auto weights = csr.neighbor_weights(u);
+            for (size_t i = 0; i < neighbors.size(); ++i) {
+                if (csr.is_directed() || u <= neighbors[i]) {
+                    graph.add_edge(u, neighbors[i], weights.empty() ? 1 : weights[i]);
+                }
+            }
+        }
+        return arcs;
+    }));
+
+    record("bfs", measure(options.repeat, [&] {
+        graph.bfs(source);
+        return arcs;
+    }));
+
+    record("cc", measure(options.repeat, [&] {
+        graph.get_connected_components();
+        return arcs;
+    }));
+
+    record("sssp-dijkstra", measure(options.repeat, [&] {
+        std::unordered_map<uint32_t, int64_t> distance;
+        std::priority_queue<std::pair<int64_t, uint32_t>, std::vector<std::pair<int64_t, uint32_t>>,
+                            std::greater<>> queue;
+        distance[source] = 0;
+        queue.emplace(0, source);
+        while (!queue.empty()) {
+            auto [d, u] = queue.top();
+            queue.pop();
+            if (d > distance[u]) {
+                continue;
+            }
+            for (const auto& [v, w] : graph.get_neighbors(u)) {
+                auto it = distance.find(v);
+                if (it == distance.end() || d + w < it->second) {
+                    distance[v] = d + w;
+                    queue.emplace(d + w, v);
+                }
+            }
+        }
+        return arcs;
+    }));
+
+    record("pagerank", measure(options.repeat, [&] {
+        std::vector<uint32_t> vertices = graph.get_vertices();
+        double n = static_cast<double>(vertices.size());
+        std::unordered_map<uint32_t, double> rank;
+        for (uint32_t v : vertices) {
+            rank[v] = 1.0 / n;
+        }
+        for (int iteration = 0; iteration < 20; ++iteration) {
+            std::unordered_map<uint32_t, double> next;
+            double dangling = 0.0;
+            for (uint32_t u : vertices) {
+                auto neighbors = graph.get_neighbors(u);
+                if (neighbors.empty()) {
+                    dangling += rank[u];
+                    continue;
+                }
+                for (const auto& [v, _] : neighbors) {
+                    next[v] += rank[u] / static_cast<double>(neighbors.size());
+                }
+            }
+            for (uint32_t v : vertices) {
+                rank[v] = 0.15 / n + 0.85 * (next[v] + dangling / n);
+            }
+        }
+        return 20 * arcs;
+    }));
+
+    if (!csr.is_directed()) {
+        uint64_t triangles = 0;   // Kept outside the lambda so the count is not optimized away
+        record("triangles", measure(options.repeat, [&] {
+            // Orient every edge towards the endpoint of higher (degree, key), then test
+            // each pair of forward neighbors with has_edge(): O(E^1.5) hash lookups
+            std::unordered_map<uint32_t, size_t> degree;
+            for (uint32_t v : graph.get_vertices()) {
+                degree[v] = graph.get_neighbors(v).size();
+            }
+            auto forward = [&](uint32_t u, uint32_t v) {
+                return degree[u] < degree[v] || (degree[u] == degree[v] && u < v);
+            };
+            triangles = 0;
+            std::vector<uint32_t> out;
+            for (const auto& [u, d] : degree) {
+                out.clear();
+                for (const auto& [v, _] : graph.get_neighbors(u)) {
+                    if (forward(u, v)) {
+                        out.push_back(v);
+                    }
+                }
+                for (size_t i = 0; i < out.size(); ++i) {
+                    for (size_t j = i + 1; j < out.size(); ++j) {
+                        triangles += graph.has_edge(out[i], out[j]);
+                    }
+                }
+            }
+            return arcs;
+        }));
+    }
+}
+
+/**
+ * @brief Compare rows with an earlier CSV run
+ * @return The number of kernels that got slower than the tolerance allows
+ */
+size_t compare_with_baseline(const std::vector<BenchmarkRow>& rows, const std::string& graph_name,
+                             const BenchmarkOptions& options) {
+    std::ifstream in(options.baseline);
+    if (!in) {
+        throw std::runtime_error("Cannot open baseline: " + options.baseline);
+    }
+    std::unordered_map<std::string, double> baseline;
+    std::string line;
+    std::getline(in, line);   // Header
+    while (std::getline(in, line)) {
+        std::stringstream fields(line);
+        std::string graph, kernel, form, seconds;
+        std::getline(fields, graph, ',');
+        std::getline(fields, kernel, ',');
+        std::getline(fields, form, ',');
+        std::getline(fields, seconds, ',');
+        if (graph == graph_name) {
+            baseline[kernel + "/" + form] = std::stod(seconds);
+        }
+    }
+
+    size_t regressions = 0;
+    for (const auto& row : rows) {
+        auto it = baseline.find(row.kernel + "/" + row.form);
+        if (it != baseline.end() && row.seconds > it->second * (1.0 + options.tolerance)) {
+            std::cerr << "REGRESSION " << row.kernel << " (" << row.form << "): " << row.seconds
+                      << " s vs " << it->second << " s baseline" << std::endl;
+            regressions++;
+        }
+    }
+    return regressions;
+}
+
+BenchmarkOptions parse_arguments(int argc, char** argv) {
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("Missing value for " + flag);
+            }
+            return argv[++i];
+        };
+        if (flag == "--graph") {
+            options.graph = value();
+        } else if (flag == "--scale") {
+            options.scale = static_cast<unsigned>(std::stoul(value()));
+        } else if (flag == "--edge-factor") {
+            options.edge_factor = std::stoull(value());
+        } else if (flag == "--max-weight") {
+            options.max_weight = std::stoi(value());
+        } else if (flag == "--file") {
+            options.file = value();
+        } else if (flag == "--format") {
+            options.format = value();
+        } else if (flag == "--directed") {
+            options.directed = true;
+        } else if (flag == "--seed") {
+            options.seed = std::stoull(value());
+        } else if (flag == "--threads") {
+            options.threads = std::stoull(value());
+        } else if (flag == "--repeat") {
+            options.repeat = std::stoull(value());
+        } else if (flag == "--hash-limit") {
+            options.hash_limit = std::stoull(value());
+        } else if (flag == "--csv") {
+            options.csv = true;
+        } else if (flag == "--baseline") {
+            options.baseline = value();
+        } else if (flag == "--tolerance") {
+            options.tolerance = std::stod(value());
+        } else {
+            throw std::invalid_argument("Unknown option: " + flag);
+        }
+    }
+    return options;
+}
+
+int main(int argc, char** argv) {
+    try {
+        BenchmarkOptions options = parse_arguments(argc, argv);
+        std::string name = options.graph == "file" ? options.file : options.graph + "-" + std::to_string(options.scale);
+
+        auto started = std::chrono::steady_clock::now();
+        CSRGraph graph = make_graph(options);
+        double load_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+        std::vector<BenchmarkRow> rows;
+        rows.push_back({"load", "csr", load_seconds, static_cast<double>(graph.arc_count()), peak_memory_mib()});
+        run_csr(graph, options, rows);
+        if (graph.arc_count() <= options.hash_limit) {
+            run_hash_map(graph, options, rows);
+        }
+
+        if (options.csv) {
+            std::cout << "graph,kernel,form,seconds,edges_per_second,peak_mib\n";
+            for (const auto& row : rows) {
+                std::cout << name << ',' << row.kernel << ',' << row.form << ',' << row.seconds << ','
+                          << row.edges / row.seconds << ',' << row.peak_mib << '\n';
+            }
+        } else {
+            std::cout << name << ": " << graph.vertex_count() << " vertices, " << graph.arc_count() << " arcs, "
+                      << (graph.is_directed() ? "directed" : "undirected")
+                      << (graph.is_weighted() ? ", weighted" : "") << "\n\n";
+            std::cout << std::left << std::setw(16) << "kernel" << std::setw(8) << "form" << std::right
+                      << std::setw(12) << "seconds" << std::setw(14) << "Medges/s" << std::setw(12) << "peak MiB" << '\n';
+            for (const auto& row : rows) {
+                std::cout << std::left << std::setw(16) << row.kernel << std::setw(8) << row.form << std::right
+                          << std::fixed << std::setprecision(4) << std::setw(12) << row.seconds
+                          << std::setprecision(1) << std::setw(14) << row.edges / row.seconds / 1e6
+                          << std::setw(12) << row.peak_mib << '\n';
+            }
+        }
+
+        if (!options.baseline.empty() && compare_with_baseline(rows, name, options) > 0) {
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,245 @@
+/**
+ * @file graph_generators.hpp
+ * @brief Deterministic synthetic graph generators (RMAT, grid, road-like, Erdős–Rényi)
+ *
+ * Edges are generated in fixed-size blocks, each with its own random stream derived
+ * from the seed and the block number, so the same seed gives the same graph for any
+ * thread count. The blocks are handed to the bulk loader's CSR builder
+ * (graph_loader.hpp), which symmetrizes, removes self-loops and deduplicates.
+ *
+ * - RMAT (Chakrabarti et al.; Graph500 Kronecker parameters by default): skewed,
+ *   power-law degrees and a small diameter, like social and web graphs. Vertex IDs
+ *   are randomly permuted so that hubs are not clustered at low IDs.
+ * - Grid: a rows x cols 4-neighbor lattice, high diameter and uniform degree.
+ * - Road-like: a grid with a fraction of streets removed, weights that vary per
+ *   segment, and a sparse set of cheap long-range "highway" edges.
+ * - Erdős–Rényi G(n, m): m edges with uniformly random endpoints.
+ *
+ * Time Complexity: O(E log V) for RMAT, O(V + E) otherwise, plus the CSR build
+ *
+ * Space Complexity: O(V + E)
+ */
+
+#ifndef GRAPH_GENERATORS_HPP
+#define GRAPH_GENERATORS_HPP
+
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <numeric>
+#include <cstdlib>
+#include <algorithm>
+#include <stdexcept>
+
+#include "csr_graph.hpp"
+#include "graph_loader.hpp"
+#include "../other/parallel_for.hpp"
+
+/**
+ * @brief Options shared by the generators
+ */
+struct GeneratorOptions {
+    uint64_t seed = 1;
+    int max_weight = 1;         // Weights are uniform in [1, max_weight]; 1 gives an unweighted graph
+    bool undirected = true;     // Store both arcs of every edge
+    size_t threads = 0;         // Worker threads (0 means default_thread_count())
+};
+
+namespace generator_detail {
+
+constexpr size_t BLOCK_EDGES = 1 << 16;
+
+// SplitMix64 finalizer: decorrelates the per-block seeds
+inline uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// Call emit(rng, slot, chunk) for every slot in [0, slots); each slot may add an edge.
+// Slots are split into blocks with independently seeded random streams.
+template<typename Emit>
+std::vector<graph_loader_detail::EdgeChunk> generate_blocks(uint64_t slots, const GeneratorOptions& options,
+                                                            Emit emit) {
+    size_t blocks = static_cast<size_t>((slots + BLOCK_EDGES - 1) / BLOCK_EDGES);
+    std::vector<graph_loader_detail::EdgeChunk> chunks(blocks);
+    parallel_for(0, blocks, [&](size_t b) {
+        std::mt19937_64 rng(mix(options.seed ^ mix(b)));
+        auto& chunk = chunks[b];
+        chunk.weighted = options.max_weight > 1;
+        uint64_t begin = b * BLOCK_EDGES;
+        uint64_t end = std::min<uint64_t>(slots, begin + BLOCK_EDGES);
+        chunk.sources.reserve(end - begin);
+        chunk.targets.reserve(end - begin);
+        chunk.weights.reserve(end - begin);
+        for (uint64_t slot = begin; slot < end; ++slot) {
+            emit(rng, slot, chunk);
+        }
+    }, 1, options.threads);
+    return chunks;
+}
+
+inline int random_weight(std::mt19937_64& rng, const GeneratorOptions& options) {
+    return options.max_weight > 1 ? static_cast<int>(rng() % static_cast<uint64_t>(options.max_weight)) + 1 : 1;
+}
+
+inline void push_edge(graph_loader_detail::EdgeChunk& chunk, uint32_t u, uint32_t v, int weight) {
+    chunk.sources.push_back(u);
+    chunk.targets.push_back(v);
+    chunk.weights.push_back(weight);   // The CSR builder expects a weight per edge even when unweighted
+}
+
+inline CSRGraph build(std::vector<graph_loader_detail::EdgeChunk>& chunks, size_t vertex_count,
+                      const GeneratorOptions& options) {
+    GraphLoadOptions load;
+    load.symmetrize = options.undirected;
+    load.deduplicate = true;
+    load.remove_self_loops = true;
+    size_t threads = options.threads == 0 ? default_thread_count() : options.threads;
+    return graph_loader_detail::build_csr(chunks, vertex_count, load, threads);
+}
+
+inline void require_vertices(uint64_t vertex_count) {
+    if (vertex_count == 0 || vertex_count >= UINT32_MAX) {
+        throw std::invalid_argument("Vertex count must be in [1, 2^32 - 1)");
+    }
+}
+
+} // namespace generator_detail
+
+/**
+ * @brief Generate an RMAT (recursive matrix) graph
+ * @param scale log2 of the number of vertices
+ * @param edge_factor Generated edges per vertex (before deduplication)
+ * @param options Seed, weights, direction and threads
+ * @param a Probability of the top-left quadrant
+ * @param b Probability of the top-right quadrant
+ * @param c Probability of the bottom-left quadrant (the rest goes to bottom-right)
+ * @return The graph with 2^scale vertices
+ * @throw std::invalid_argument if the scale or the probabilities are invalid
+ */
+inline CSRGraph generate_rmat(unsigned scale, size_t edge_factor = 16, const GeneratorOptions& options = {},
+                              double a = 0.57, double b = 0.19, double c = 0.19) {
+    if (scale == 0 || scale > 31) {
+        throw std::invalid_argument("RMAT scale must be in [1, 31]");
+    }
+    if (a < 0 || b < 0 || c < 0 || a + b + c > 1) {
+        throw std::invalid_argument("RMAT quadrant probabilities must be non-negative and sum to at most 1");
+    }
+    uint64_t n = uint64_t(1) << scale;
+    generator_detail::require_vertices(n);
+
+    std::vector<uint32_t> permutation(n);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    std::shuffle(permutation.begin(), permutation.end(), std::mt19937_64(generator_detail::mix(options.seed)));
+
+    auto chunks = generator_detail::generate_blocks(n * edge_factor, options,
+                                                    [&](std::mt19937_64& rng, uint64_t, auto& chunk) {
+        std::uniform_real_distribution<double> coin(0.0, 1.0);
+        uint32_t u = 0;
+        uint32_t v = 0;
+        for (unsigned bit = 0; bit < scale; ++bit) {
+            double r = coin(rng);
+            u = (u << 1) | (r >= a + b);
+            v = (v << 1) | ((r >= a && r < a + b) || r >= a + b + c);
+        }
+        generator_detail::push_edge(chunk, permutation[u], permutation[v], generator_detail::random_weight(rng, options));
+    });
+    return generator_detail::build(chunks, n, options);
+}
+
+/**
+ * @brief Generate an Erdős–Rényi G(n, m) graph
+ * @param vertex_count Number of vertices
+ * @param edge_count Number of generated edges (before deduplication)
+ * @param options Seed, weights, direction and threads
+ * @return The graph
+ * @throw std::invalid_argument if vertex_count is 0 or too large
+ */
+inline CSRGraph generate_erdos_renyi(size_t vertex_count, size_t edge_count, const GeneratorOptions& options = {}) {
+    generator_detail::require_vertices(vertex_count);
+    auto chunks = generator_detail::generate_blocks(edge_count, options,
+                                                    [&](std::mt19937_64& rng, uint64_t, auto& chunk) {
+        uint32_t u = static_cast<uint32_t>(rng() % vertex_count);
+        uint32_t v = static_cast<uint32_t>(rng() % vertex_count);
+        generator_detail::push_edge(chunk, u, v, generator_detail::random_weight(rng, options));
+    });
+    return generator_detail::build(chunks, vertex_count, options);
+}
+
+/**
+ * @brief Generate a rows x cols 4-neighbor grid; vertex (r, c) has ID r * cols + c
+ * @param rows Number of rows
+ * @param cols Number of columns
+ * @param options Seed, weights, direction and threads
+ * @return The graph
+ * @throw std::invalid_argument if the grid is empty or too large
+ */
+inline CSRGraph generate_grid(size_t rows, size_t cols, const GeneratorOptions& options = {}) {
+    uint64_t n = static_cast<uint64_t>(rows) * cols;
+    generator_detail::require_vertices(n);
+    // Slot 2v is the edge to the right of vertex v, slot 2v + 1 the edge below it
+    auto chunks = generator_detail::generate_blocks(2 * n, options, [&](std::mt19937_64& rng, uint64_t slot, auto& chunk) {
+        uint64_t v = slot / 2;
+        bool right = slot % 2 == 0;
+        if ((right && v % cols + 1 < cols) || (!right && v / cols + 1 < rows)) {
+            generator_detail::push_edge(chunk, static_cast<uint32_t>(v), static_cast<uint32_t>(right ? v + 1 : v + cols),
+                                        generator_detail::random_weight(rng, options));
+        }
+    });
+    return generator_detail::build(chunks, n, options);
+}
+
+/**
+ * @brief Generate a road-network-like graph: a sparse, weighted grid with a few highways
+ * @param rows Number of rows
+ * @param cols Number of columns
+ * @param options Seed, direction and threads; max_weight is the base street length
+ *                (values below 10 are raised to 10 so that weights can vary)
+ * @param removed Fraction of grid streets to drop
+ * @param highways Long-range edges per vertex; each costs about half its Manhattan length
+ * @return The graph
+ * @throw std::invalid_argument if the grid is empty or too large
+ */
+inline CSRGraph generate_road_network(size_t rows, size_t cols, const GeneratorOptions& options = {},
+                                      double removed = 0.15, double highways = 0.005) {
+    uint64_t n = static_cast<uint64_t>(rows) * cols;
+    generator_detail::require_vertices(n);
+    GeneratorOptions weighted = options;
+    weighted.max_weight = std::max(options.max_weight, 10);
+    int base = weighted.max_weight;
+
+    uint64_t streets = 2 * n;
+    uint64_t long_edges = static_cast<uint64_t>(static_cast<double>(n) * highways);
+    auto chunks = generator_detail::generate_blocks(streets + long_edges, weighted,
+                                                    [&](std::mt19937_64& rng, uint64_t slot, auto& chunk) {
+        std::uniform_real_distribution<double> coin(0.0, 1.0);
+        if (slot < streets) {
+            uint64_t v = slot / 2;
+            bool right = slot % 2 == 0;
+            bool border = right ? v % cols + 1 == cols : v / cols + 1 == rows;
+            if (border || coin(rng) < removed) {
+                return;
+            }
+            // Street lengths vary between half and one and a half times the base length
+            int weight = std::max(1, static_cast<int>(base * (0.5 + coin(rng))));
+            generator_detail::push_edge(chunk, static_cast<uint32_t>(v), static_cast<uint32_t>(right ? v + 1 : v + cols),
+                                        weight);
+            return;
+        }
+        // Highways reach up to 50 blocks away in each direction
+        uint64_t u = rng() % n;
+        int64_t ur = static_cast<int64_t>(u / cols);
+        int64_t uc = static_cast<int64_t>(u % cols);
+        int64_t r = std::clamp<int64_t>(ur + static_cast<int64_t>(rng() % 101) - 50, 0, static_cast<int64_t>(rows) - 1);
+        int64_t c = std::clamp<int64_t>(uc + static_cast<int64_t>(rng() % 101) - 50, 0, static_cast<int64_t>(cols) - 1);
+        uint64_t v = static_cast<uint64_t>(r) * cols + static_cast<uint64_t>(c);
+        int64_t manhattan = std::llabs(r - ur) + std::llabs(c - uc);
+        int weight = static_cast<int>(std::max<int64_t>(1, manhattan * base / 2));
+        generator_detail::push_edge(chunk, static_cast<uint32_t>(u), static_cast<uint32_t>(v), weight);
+    });
+    return generator_detail::build(chunks, n, weighted);
+}
+
+#endif // GRAPH_GENERATORS_HPP
@@ -0,0 +1,565 @@
+/**
+ * @file graph_loader.hpp
+ * @brief Parallel bulk loader from edge-list files straight to a CSRGraph
+ *
+ * Supported inputs:
+ * - SNAP text edge lists: one "source target [weight]" per line, '#' or '%' comments
+ * - Matrix Market coordinate files (1-based). "symmetric" files are symmetrized into an
+ *   undirected graph; "skew-symmetric" files get the mirror of every off-diagonal entry
+ *   with the negated weight, as a directed graph. "complex" and "hermitian" files are
+ *   rejected.
+ * - Binary edge lists: little-endian uint32 (source, target) pairs, optionally
+ *   followed by an int32 weight per edge
+ *
+ * Weights are stored as int. Text weights (including Matrix Market "real" values) are
+ * rounded to the nearest integer, so 0.3 loads as 0 and 1.5 as 2; scale real-valued
+ * inputs beforehand if the fraction matters.
+ *
+ * The file is memory-mapped and split into chunks at line boundaries. Every chunk is
+ * parsed on its own thread with a hand-written integer parser. The CSR arrays are then
+ * built without any per-edge hashing: the arcs are radix-partitioned by source vertex
+ * range, and every partition independently counts degrees, takes a prefix sum, scatters
+ * its arcs and sorts (optionally deduplicates) its neighbor lists, all inside a
+ * cache-sized slice of the output. Vertex IDs are taken from the file as they are.
+ *
+ * Time Complexity: O(E / threads + V) plus the per-vertex sorts, O(E log d) total
+ *
+ * Space Complexity: O(V + E); parsed edges are released as they are partitioned
+ */
+
+#ifndef GRAPH_LOADER_HPP
+#define GRAPH_LOADER_HPP
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "csr_graph.hpp"
+#include "../other/parallel_for.hpp"
+
+/**
+ * @brief Layout of an edge-list file
+ */
+enum class EdgeListFormat {
+    SNAP,           // Text, one "source target [weight]" per line
+    MatrixMarket,   // Matrix Market coordinate format
+    Binary,         // uint32 source, uint32 target
+    BinaryWeighted  // uint32 source, uint32 target, int32 weight
+};
+
+/**
+ * @brief Options for load_graph() and parse_graph()
+ */
+struct GraphLoadOptions {
+    bool symmetrize = false;         // Store every edge in both directions (undirected result)
+    bool deduplicate = false;        // Keep one arc per (source, target), the lightest one
+    bool remove_self_loops = false;  // Drop arcs from a vertex to itself
+    size_t threads = 0;              // Worker threads (0 means default_thread_count())
+};
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file (POSIX)
+ */
+class MappedFile {
+private:
+    void* address = nullptr;
+    size_t length = 0;
+
+public:
+    /**
+     * @brief Map a file into memory
+     * @param path The file to map
+     * @throw std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat " + path);
+        }
+        length = static_cast<size_t>(info.st_size);
+        if (length > 0) {
+            address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED) {
+                address = nullptr;
+                ::close(fd);
+                throw std::runtime_error("Cannot map " + path);
+            }
+            ::madvise(address, length, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        if (address) {
+            ::munmap(address, length);
+        }
+    }
+
+    /**
+     * @brief Get the file contents
+     */
+    std::string_view data() const {
+        return {static_cast<const char*>(address), length};
+    }
+};
+
+namespace graph_loader_detail {
+
+struct EdgeChunk {
+    std::vector<uint32_t> sources;
+    std::vector<uint32_t> targets;
+    std::vector<int> weights;
+    uint64_t max_vertex = 0;
+    bool weighted = false;
+};
+
+inline bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == ',';
+}
+
+// Parse an unsigned integer at p; returns false if there is none before the end of the line
+inline bool parse_unsigned(const char*& p, const char* end, uint64_t& value) {
+    while (p < end && is_space(*p)) {
+        ++p;
+    }
+    if (p == end || *p < '0' || *p > '9') {
+        return false;
+    }
+    value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    return true;
+}
+
+// Parse an optional weight (integer or real, rounded to the nearest integer, halves away from zero)
+inline bool parse_weight(const char*& p, const char* end, int& weight) {
+    while (p < end && is_space(*p)) {
+        ++p;
+    }
+    if (p == end || *p == '\n') {
+        return false;
+    }
+    double value = 0;
+    auto [next, error] = std::from_chars(p, end, value);
+    if (error != std::errc()) {
+        return false;
+    }
+    p = next;
+    weight = static_cast<int>(std::lround(value));
+    return true;
+}
+
+// Advance p to the first character of the next line
+inline const char* next_line(const char* p, const char* end) {
+    if (p >= end) {
+        return end;
+    }
+    const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+    return newline ? newline + 1 : end;
+}
+
+inline void parse_text_chunk(const char* p, const char* end, uint64_t base, EdgeChunk& chunk, bool& malformed) {
+    while (p < end) {
+        const char* line_end = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!line_end) {
+            line_end = end;
+        }
+        const char* q = p;
+        while (q < line_end && is_space(*q)) {
+            ++q;
+        }
+        if (q < line_end && *q != '#' && *q != '%') {
+            uint64_t u = 0;
+            uint64_t v = 0;
+            int weight = 1;
+            if (!parse_unsigned(q, line_end, u) || !parse_unsigned(q, line_end, v) || u < base || v < base ||
+                u - base >= UINT32_MAX || v - base >= UINT32_MAX) {
+                malformed = true;
+                return;
+            }
+            if (parse_weight(q, line_end, weight)) {
+                chunk.weighted = true;
+            }
+            u -= base;
+            v -= base;
+            chunk.sources.push_back(static_cast<uint32_t>(u));
+            chunk.targets.push_back(static_cast<uint32_t>(v));
+            chunk.weights.push_back(weight);
+            chunk.max_vertex = std::max({chunk.max_vertex, u, v});
+        }
+        p = line_end + (line_end < end ? 1 : 0);
+    }
+}
+
+// The whitespace-separated words of a Matrix Market banner, lowercased
+inline std::vector<std::string> banner_fields(std::string_view banner) {
+    std::vector<std::string> fields;
+    size_t i = 0;
+    while (i < banner.size()) {
+        while (i < banner.size() && (banner[i] == ' ' || banner[i] == '\t' || banner[i] == '\r' || banner[i] == '\n')) {
+            ++i;
+        }
+        std::string field;
+        while (i < banner.size() && banner[i] != ' ' && banner[i] != '\t' && banner[i] != '\r' && banner[i] != '\n') {
+            field.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(banner[i++]))));
+        }
+        if (!field.empty()) {
+            fields.push_back(std::move(field));
+        }
+    }
+    return fields;
+}
+
+// Skew-symmetric matrices store one triangle: add A(j, i) = -A(i, j) for every off-diagonal entry
+inline void add_negated_mirrors(EdgeChunk& chunk) {
+    size_t count = chunk.sources.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (chunk.sources[i] != chunk.targets[i]) {
+            chunk.sources.push_back(chunk.targets[i]);
+            chunk.targets.push_back(chunk.sources[i]);
+            chunk.weights.push_back(-chunk.weights[i]);
+        }
+    }
+}
+
+inline std::vector<EdgeChunk> parse_text(std::string_view body, uint64_t base, size_t threads) {
+    size_t pieces = std::max<size_t>(1, std::min(threads * 4, body.size() / (1 << 16) + 1));
+    std::vector<const char*> bounds(pieces + 1);
+    const char* begin = body.data();
+    const char* end = body.data() + body.size();
+    bounds[0] = begin;
+    bounds[pieces] = end;
+    for (size_t i = 1; i < pieces; ++i) {
+        const char* guess = begin + body.size() * i / pieces;
+        bounds[i] = std::max(bounds[i - 1], guess == begin ? begin : next_line(guess - 1, end));
+    }
+
+    std::vector<EdgeChunk> chunks(pieces);
+    std::vector<char> malformed(pieces, 0);
+    parallel_for(0, pieces, [&](size_t i) {
+        bool bad = false;
+        parse_text_chunk(bounds[i], bounds[i + 1], base, chunks[i], bad);
+        malformed[i] = bad;
+    }, 1, threads);
+
+    if (std::find(malformed.begin(), malformed.end(), 1) != malformed.end()) {
+        throw std::runtime_error("Malformed edge line");
+    }
+    return chunks;
+}
+
+inline std::vector<EdgeChunk> parse_binary(std::string_view data, bool weighted, size_t threads) {
+    size_t record = weighted ? 12 : 8;
+    if (data.size() % record != 0) {
+        throw std::runtime_error("Binary edge list size is not a multiple of the record size");
+    }
+    size_t edges = data.size() / record;
+    size_t pieces = std::max<size_t>(1, std::min(threads * 4, edges / 65536 + 1));
+
+    std::vector<EdgeChunk> chunks(pieces);
+    parallel_for(0, pieces, [&](size_t i) {
+        size_t lo = edges * i / pieces;
+        size_t hi = edges * (i + 1) / pieces;
+        EdgeChunk& chunk = chunks[i];
+        chunk.weighted = weighted;
+        chunk.sources.resize(hi - lo);
+        chunk.targets.resize(hi - lo);
+        chunk.weights.resize(hi - lo, 1);
+        for (size_t e = lo; e < hi; ++e) {
+            const char* p = data.data() + e * record;
+            uint32_t u;
+            uint32_t v;
+            std::memcpy(&u, p, 4);
+            std::memcpy(&v, p + 4, 4);
+            if (weighted) {
+                std::memcpy(&chunk.weights[e - lo], p + 8, 4);
+            }
+            chunk.sources[e - lo] = u;
+            chunk.targets[e - lo] = v;
+            chunk.max_vertex = std::max<uint64_t>({chunk.max_vertex, u, v});
+        }
+    }, 1, threads);
+    return chunks;
+}
+
+struct StagedArc {
+    uint32_t source;
+    uint32_t target;
+    int weight;
+};
+
+inline CSRGraph build_csr(std::vector<EdgeChunk>& chunks, size_t vertex_count, const GraphLoadOptions& options,
+                          size_t threads) {
+    bool weighted = false;
+    uint64_t edge_count = 0;
+    for (const auto& chunk : chunks) {
+        weighted = weighted || chunk.weighted;
+        edge_count += chunk.sources.size();
+    }
+    auto keep = [&](uint32_t u, uint32_t v) {
+        return !(options.remove_self_loops && u == v);
+    };
+    auto mirrored = [&](uint32_t u, uint32_t v) {
+        return options.symmetrize && u != v;
+    };
+
+    // Scattering arcs straight into the CSR arrays writes all over memory (a cache and
+    // TLB miss per arc). Instead, arcs are first partitioned into buckets of consecutive
+    // source vertices, each owning a cache-sized slice of the target array, and every
+    // bucket is then counted, scattered and sorted locally.
+    uint64_t arc_estimate = options.symmetrize ? 2 * edge_count : edge_count;
+    size_t buckets = static_cast<size_t>(std::clamp<uint64_t>(arc_estimate / 65536, 1, 4096));
+    buckets = std::min(buckets, std::max<size_t>(1, vertex_count));
+    size_t bucket_width = (vertex_count + buckets - 1) / buckets;
+    auto bucket_of = [&](uint32_t v) {
+        return v / bucket_width;
+    };
+
+    // Per-chunk bucket histograms
+    std::vector<uint64_t> cursors(chunks.size() * buckets, 0);
+    parallel_for(0, chunks.size(), [&](size_t c) {
+        uint64_t* histogram = &cursors[c * buckets];
+        const EdgeChunk& chunk = chunks[c];
+        for (size_t e = 0; e < chunk.sources.size(); ++e) {
+            uint32_t u = chunk.sources[e];
+            uint32_t v = chunk.targets[e];
+            if (keep(u, v)) {
+                histogram[bucket_of(u)]++;
+                if (mirrored(u, v)) {
+                    histogram[bucket_of(v)]++;
+                }
+            }
+        }
+    }, 1, threads);
+
+    std::vector<uint64_t> bucket_start(buckets + 1, 0);
+    uint64_t running = 0;
+    for (size_t b = 0; b < buckets; ++b) {
+        bucket_start[b] = running;
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            uint64_t count = cursors[c * buckets + b];
+            cursors[c * buckets + b] = running;
+            running += count;
+        }
+    }
+    bucket_start[buckets] = running;
+
+    // Partition into the staging area, releasing every parsed chunk as soon as it is done
+    std::vector<StagedArc> staged(running);
+    parallel_for(0, chunks.size(), [&](size_t c) {
+        uint64_t* cursor = &cursors[c * buckets];
+        EdgeChunk& chunk = chunks[c];
+        for (size_t e = 0; e < chunk.sources.size(); ++e) {
+            uint32_t u = chunk.sources[e];
+            uint32_t v = chunk.targets[e];
+            if (keep(u, v)) {
+                staged[cursor[bucket_of(u)]++] = {u, v, chunk.weights[e]};
+                if (mirrored(u, v)) {
+                    staged[cursor[bucket_of(v)]++] = {v, u, chunk.weights[e]};
+                }
+            }
+        }
+        chunk = EdgeChunk();
+    }, 1, threads);
+
+    // Per bucket: degree count, prefix sum, scatter, and sort (plus dedup) of each list
+    std::vector<uint64_t> offsets(vertex_count + 1, 0);
+    std::vector<uint32_t> targets(running);
+    std::vector<int> weights(weighted ? running : 0);
+    std::vector<uint64_t> unique_degree(vertex_count);
+    std::vector<std::vector<uint64_t>> local_cursor(std::max<size_t>(1, threads));
+    std::vector<std::vector<std::pair<uint32_t, int>>> pairs_scratch(std::max<size_t>(1, threads));
+
+    parallel_for_blocks(0, buckets, 1, [&](size_t b, size_t, size_t worker) {
+        size_t lo = std::min(vertex_count, b * bucket_width);
+        size_t hi = std::min(vertex_count, lo + bucket_width);
+        auto& cursor = local_cursor[worker];
+        cursor.assign(hi - lo + 1, 0);
+
+        for (uint64_t i = bucket_start[b]; i < bucket_start[b + 1]; ++i) {
+            cursor[staged[i].source - lo + 1]++;
+        }
+        cursor[0] = bucket_start[b];
+        for (size_t v = lo; v < hi; ++v) {
+            cursor[v - lo + 1] += cursor[v - lo];
+            offsets[v] = cursor[v - lo];
+        }
+        for (uint64_t i = bucket_start[b]; i < bucket_start[b + 1]; ++i) {
+            uint64_t slot = cursor[staged[i].source - lo]++;
+            targets[slot] = staged[i].target;
+            if (weighted) {
+                weights[slot] = staged[i].weight;
+            }
+        }
+
+        auto& pairs = pairs_scratch[worker];
+        for (size_t v = lo; v < hi; ++v) {
+            uint64_t first = offsets[v];
+            uint64_t last = v + 1 < hi ? offsets[v + 1] : bucket_start[b + 1];
+            if (!weighted) {
+                std::sort(targets.begin() + first, targets.begin() + last);
+                unique_degree[v] = options.deduplicate
+                    ? static_cast<uint64_t>(std::unique(targets.begin() + first, targets.begin() + last) - (targets.begin() + first))
+                    : last - first;
+                continue;
+            }
+            pairs.clear();
+            for (uint64_t arc = first; arc < last; ++arc) {
+                pairs.emplace_back(targets[arc], weights[arc]);
+            }
+            std::sort(pairs.begin(), pairs.end());
+            if (options.deduplicate) {
+                // Sorted by (target, weight): the first copy of each target is the lightest
+                pairs.erase(std::unique(pairs.begin(), pairs.end(), [](const auto& x, const auto& y) {
+                    return x.first == y.first;
+                }), pairs.end());
+            }
+            for (size_t i = 0; i < pairs.size(); ++i) {
+                targets[first + i] = pairs[i].first;
+                weights[first + i] = pairs[i].second;
+            }
+            unique_degree[v] = pairs.size();
+        }
+    }, threads);
+    offsets[vertex_count] = running;
+    staged = std::vector<StagedArc>();
+
+    if (options.deduplicate) {
+        std::vector<uint64_t> compact(vertex_count + 1, 0);
+        for (size_t v = 0; v < vertex_count; ++v) {
+            compact[v + 1] = compact[v] + unique_degree[v];
+        }
+        std::vector<uint32_t> compact_targets(compact.back());
+        std::vector<int> compact_weights(weighted ? compact.back() : 0);
+        parallel_for(0, vertex_count, [&](size_t v) {
+            std::copy_n(targets.data() + offsets[v], unique_degree[v], compact_targets.data() + compact[v]);
+            if (weighted) {
+                std::copy_n(weights.data() + offsets[v], unique_degree[v], compact_weights.data() + compact[v]);
+            }
+        }, 4096, threads);
+        offsets.swap(compact);
+        targets.swap(compact_targets);
+        weights.swap(compact_weights);
+    }
+
+    return CSRGraph(std::move(offsets), std::move(targets), std::move(weights), !options.symmetrize);
+}
+
+} // namespace graph_loader_detail
+
+/**
+ * @brief Build a CSR graph from an edge list held in memory
+ * @param data The raw file contents
+ * @param format The layout of the contents
+ * @param options Symmetrization, deduplication and thread count
+ * @return The CSR graph; it is directed unless options.symmetrize is set or the
+ *         Matrix Market header declares a symmetric matrix. Text weights, including
+ *         Matrix Market real values, are rounded to the nearest integer
+ * @throw std::runtime_error if the input is malformed, or is a complex or Hermitian
+ *        Matrix Market file
+ */
+inline CSRGraph parse_graph(std::string_view data, EdgeListFormat format, GraphLoadOptions options = {}) {
+    using namespace graph_loader_detail;
+    size_t threads = options.threads == 0 ? default_thread_count() : options.threads;
+
+    std::vector<EdgeChunk> chunks;
+    uint64_t declared_vertices = 0;
+    bool skew_symmetric = false;
+
+    if (format == EdgeListFormat::MatrixMarket) {
+        const char* p = data.data();
+        const char* end = data.data() + data.size();
+        // %%MatrixMarket matrix coordinate <field> <symmetry>
+        std::vector<std::string> banner = banner_fields(std::string_view(p, static_cast<size_t>(next_line(p, end) - p)));
+        if (banner.size() < 5 || banner[0] != "%%matrixmarket" || banner[1] != "matrix" || banner[2] != "coordinate") {
+            throw std::runtime_error("Not a Matrix Market coordinate file");
+        }
+        const std::string& field = banner[3];
+        const std::string& symmetry = banner[4];
+        if (field == "complex" || symmetry == "hermitian") {
+            throw std::runtime_error("Complex and Hermitian Matrix Market files are not supported");
+        }
+        if (field != "real" && field != "double" && field != "integer" && field != "pattern") {
+            throw std::runtime_error("Unknown Matrix Market field type");
+        }
+        if (symmetry == "symmetric") {
+            options.symmetrize = true;
+        } else if (symmetry == "skew-symmetric") {
+            skew_symmetric = true;
+        } else if (symmetry != "general") {
+            throw std::runtime_error("Unknown Matrix Market symmetry type");
+        }
+        // Skip comments up to the "rows columns entries" line
+        while (p < end && (*p == '%' || *p == '\n' || *p == '\r')) {
+            p = next_line(p, end);
+        }
+        uint64_t rows = 0;
+        uint64_t columns = 0;
+        uint64_t entries = 0;
+        const char* line_end = next_line(p, end);
+        if (!parse_unsigned(p, line_end, rows) || !parse_unsigned(p, line_end, columns) ||
+            !parse_unsigned(p, line_end, entries)) {
+            throw std::runtime_error("Malformed Matrix Market size line");
+        }
+        declared_vertices = std::max(rows, columns);
+        chunks = parse_text(std::string_view(line_end, static_cast<size_t>(end - line_end)), 1, threads);
+        if (skew_symmetric) {
+            parallel_for(0, chunks.size(), [&](size_t c) {
+                add_negated_mirrors(chunks[c]);
+            }, 1, threads);
+        }
+    } else if (format == EdgeListFormat::SNAP) {
+        chunks = parse_text(data, 0, threads);
+    } else {
+        chunks = parse_binary(data, format == EdgeListFormat::BinaryWeighted, threads);
+    }
+
+    uint64_t vertex_count = declared_vertices;
+    for (const auto& chunk : chunks) {
+        if (!chunk.sources.empty()) {
+            vertex_count = std::max(vertex_count, chunk.max_vertex + 1);
+        }
+    }
+    if (vertex_count >= UINT32_MAX) {
+        throw std::runtime_error("Graph is too large for 32-bit vertex IDs");
+    }
+    return build_csr(chunks, static_cast<size_t>(vertex_count), options, threads);
+}
+
+/**
+ * @brief Memory-map an edge-list file and build a CSR graph from it
+ * @param path The file to load
+ * @param format The layout of the file
+ * @param options Symmetrization, deduplication and thread count
+ * @return The CSR graph (see parse_graph())
+ * @throw std::runtime_error if the file cannot be read or is malformed
+ */
+inline CSRGraph load_graph(const std::string& path, EdgeListFormat format, const GraphLoadOptions& options = {}) {
+    MappedFile file(path);
+    return parse_graph(file.data(), format, options);
+}
+
+#endif // GRAPH_LOADER_HPP
@@ -0,0 +1,382 @@
+/**
+ * @file mst.hpp
+ * @brief Minimum spanning forests of an undirected CSRGraph (parallel Borůvka, filter-Kruskal)
+ *
+ * Edges are compared by (weight, smaller endpoint, larger endpoint, arc index), a strict
+ * total order, so the minimum spanning forest is unique and both algorithms return
+ * exactly the same edges. Each tree edge is reported as the index of its arc stored at
+ * the smaller endpoint (the first such arc among equal parallel edges).
+ *
+ * - Borůvka: every round, each vertex finds its lightest arc leaving its component,
+ *   each component keeps the lightest of those (a compare-and-swap per vertex), and
+ *   the chosen edges are linked in a shared ConcurrentDisjointSet. Every round at least
+ *   halves the number of components.
+ * - Filter-Kruskal (Osipov, Sanders, Singler 2009): partition the edges around a pivot
+ *   weight, solve the light half, drop heavy edges that now join vertices of the same
+ *   tree, then solve what is left. Partitioning and filtering run in parallel; small
+ *   ranges are sorted and scanned like classic Kruskal.
+ * - minimum_spanning_forest_reference(): plain sequential Kruskal, for verification.
+ *
+ * Self-loops are ignored. The graph must be undirected.
+ *
+ * Time Complexity:
+ * - Borůvka: O((V + E) log V) work
+ * - Filter-Kruskal: O(E + V log V log(E / V)) expected work
+ * - Reference: O(E log E)
+ *
+ * Space Complexity: O(V) for Borůvka, O(E) for the Kruskal variants
+ */
+
+#ifndef MST_HPP
+#define MST_HPP
+
+#include <vector>
+#include <tuple>
+#include <atomic>
+#include <random>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include "csr_graph.hpp"
+#include "../other/disjoint_set.hpp"
+#include "../other/parallel_for.hpp"
+
+/**
+ * @brief A minimum spanning forest as a list of arc indices
+ */
+struct SpanningForest {
+    std::vector<uint64_t> arcs;     // One arc per tree edge, in ascending arc index order
+    int64_t total_weight = 0;
+    size_t trees = 0;               // Number of trees (connected components, isolated vertices included)
+};
+
+namespace mst_detail {
+
+inline constexpr uint64_t NO_ARC = UINT64_MAX;
+inline constexpr uint32_t NO_VERTEX = UINT32_MAX;
+
+struct WeightedEdge {
+    int weight;
+    uint32_t u;     // Smaller endpoint
+    uint32_t v;     // Larger endpoint
+    uint64_t arc;   // Index of the arc u -> v
+
+    bool operator<(const WeightedEdge& other) const {
+        return std::tie(weight, u, v, arc) < std::tie(other.weight, other.u, other.v, other.arc);
+    }
+};
+
+inline void require_undirected(const CSRGraph& graph) {
+    if (graph.is_directed()) {
+        throw std::invalid_argument("Minimum spanning forests require an undirected graph");
+    }
+}
+
+// Every non-loop edge once, as its arc from the smaller endpoint
+inline std::vector<WeightedEdge> collect_edges(const CSRGraph& graph, size_t threads) {
+    size_t n = graph.vertex_count();
+    const auto& offsets = graph.offsets();
+    const auto& targets = graph.targets();
+    std::vector<uint64_t> start(n + 1, 0);
+    parallel_for(0, n, [&](size_t u) {
+        auto neighbors = graph.neighbors(static_cast<uint32_t>(u));
+        start[u + 1] = neighbors.end() - std::upper_bound(neighbors.begin(), neighbors.end(), static_cast<uint32_t>(u));
+    }, 4096, threads);
+    for (size_t u = 0; u < n; ++u) {
+        start[u + 1] += start[u];
+    }
+    std::vector<WeightedEdge> edges(start[n]);
+    parallel_for(0, n, [&](size_t u) {
+        uint64_t slot = start[u];
+        for (uint64_t arc = offsets[u]; arc < offsets[u + 1]; ++arc) {
+            if (targets[arc] > u) {
+                edges[slot++] = {graph.weight(arc), static_cast<uint32_t>(u), targets[arc], arc};
+            }
+        }
+    }, 4096, threads);
+    return edges;
+}
+
+inline SpanningForest finish(const CSRGraph& graph, std::vector<uint64_t> arcs) {
+    SpanningForest forest;
+    std::sort(arcs.begin(), arcs.end());
+    for (uint64_t arc : arcs) {
+        forest.total_weight += graph.weight(arc);
+    }
+    forest.trees = graph.vertex_count() - arcs.size();
+    forest.arcs = std::move(arcs);
+    return forest;
+}
+
+// Stable parallel split of edges[lo, hi) into those satisfying keep (moved to the front)
+// and the rest; returns the split point. buffer must be at least as large as edges.
+template<typename Predicate>
+size_t parallel_split(std::vector<WeightedEdge>& edges, size_t lo, size_t hi, Predicate keep,
+                      std::vector<WeightedEdge>& buffer, size_t threads) {
+    constexpr size_t grain = 1 << 14;
+    size_t blocks = (hi - lo + grain - 1) / grain;
+    std::vector<size_t> kept(blocks + 1, 0);
+    parallel_for(0, blocks, [&](size_t b) {
+        size_t count = 0;
+        for (size_t i = lo + b * grain; i < std::min(hi, lo + (b + 1) * grain); ++i) {
+            count += keep(edges[i]);
+        }
+        kept[b + 1] = count;
+    }, 1, threads);
+    for (size_t b = 0; b < blocks; ++b) {
+        kept[b + 1] += kept[b];
+    }
+    size_t total_kept = kept[blocks];
+    parallel_for(0, blocks, [&](size_t b) {
+        size_t front = lo + kept[b];
+        size_t back = lo + total_kept + (b * grain - kept[b]);
+        for (size_t i = lo + b * grain; i < std::min(hi, lo + (b + 1) * grain); ++i) {
+            buffer[keep(edges[i]) ? front++ : back++] = edges[i];
+        }
+    }, 1, threads);
+    parallel_for(lo, hi, [&](size_t i) {
+        edges[i] = buffer[i];
+    }, 1 << 16, threads);
+    return lo + total_kept;
+}
+
+class FilterKruskal {
+private:
+    std::vector<WeightedEdge>& edges;
+    std::vector<WeightedEdge> buffer;
+    ConcurrentDisjointSet sets;
+    std::vector<uint64_t>& tree;
+    size_t threads;
+    std::mt19937_64 rng{0x6d737466u};
+
+    static constexpr size_t BASE_CASE = 1 << 15;
+
+    void kruskal(size_t lo, size_t hi) {
+        std::sort(edges.begin() + static_cast<std::ptrdiff_t>(lo), edges.begin() + static_cast<std::ptrdiff_t>(hi));
+        for (size_t i = lo; i < hi; ++i) {
+            if (sets.unite(edges[i].u, edges[i].v)) {
+                tree.push_back(edges[i].arc);
+            }
+        }
+    }
+
+public:
+    FilterKruskal(std::vector<WeightedEdge>& edges, size_t vertex_count, std::vector<uint64_t>& tree, size_t threads)
+        : edges(edges), buffer(edges.size()), sets(vertex_count), tree(tree), threads(threads) {}
+
+    void solve(size_t lo, size_t hi) {
+        if (hi - lo <= BASE_CASE) {
+            kruskal(lo, hi);
+            return;
+        }
+        // Median of three random edges as the pivot
+        std::uniform_int_distribution<size_t> pick(lo, hi - 1);
+        WeightedEdge a = edges[pick(rng)];
+        WeightedEdge b = edges[pick(rng)];
+        WeightedEdge c = edges[pick(rng)];
+        WeightedEdge pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+        size_t middle = parallel_split(edges, lo, hi, [&](const WeightedEdge& e) { return !(pivot < e); },
+                                       buffer, threads);
+        if (middle == hi) {
+            kruskal(lo, hi);   // Pivot was the maximum: splitting again would not make progress
+            return;
+        }
+        solve(lo, middle);
+        // No unites run during the filter, so concurrent finds are safe
+        size_t end = parallel_split(edges, middle, hi, [&](const WeightedEdge& e) {
+            return sets.find(e.u) != sets.find(e.v);
+        }, buffer, threads);
+        if (end > middle) {
+            solve(middle, end);
+        }
+    }
+};
+
+} // namespace mst_detail
+
+/**
+ * @brief Minimum spanning forest by sequential Kruskal (reference implementation)
+ * @param graph The graph (undirected)
+ * @return The forest
+ * @throw std::invalid_argument if the graph is directed
+ */
+inline SpanningForest minimum_spanning_forest_reference(const CSRGraph& graph) {
+    mst_detail::require_undirected(graph);
+    std::vector<mst_detail::WeightedEdge> edges = mst_detail::collect_edges(graph, 1);
+    std::sort(edges.begin(), edges.end());
+    DisjointSet sets(graph.vertex_count());
+    std::vector<uint64_t> tree;
+    for (const auto& edge : edges) {
+        if (sets.unite(edge.u, edge.v)) {
+            tree.push_back(edge.arc);
+        }
+    }
+    return mst_detail::finish(graph, std::move(tree));
+}
+
+/**
+ * @brief Minimum spanning forest by filter-Kruskal with parallel partitioning and filtering
+ * @param graph The graph (undirected)
+ * @param threads Worker threads (0 means default_thread_count())
+ * @return The forest
+ * @throw std::invalid_argument if the graph is directed
+ */
+inline SpanningForest minimum_spanning_forest_kruskal(const CSRGraph& graph, size_t threads = 0) {
+    mst_detail::require_undirected(graph);
+    threads = threads == 0 ? default_thread_count() : threads;
+    std::vector<mst_detail::WeightedEdge> edges = mst_detail::collect_edges(graph, threads);
+    std::vector<uint64_t> tree;
+    tree.reserve(graph.vertex_count());
+    mst_detail::FilterKruskal solver(edges, graph.vertex_count(), tree, threads);
+    solver.solve(0, edges.size());
+    return mst_detail::finish(graph, std::move(tree));
+}
+
+/**
+ * @brief Minimum spanning forest by parallel Borůvka directly on the CSR arrays
+ * @param graph The graph (undirected)
+ * @param threads Worker threads (0 means default_thread_count())
+ * @return The forest
+ * @throw std::invalid_argument if the graph is directed
+ */
+inline SpanningForest minimum_spanning_forest_boruvka(const CSRGraph& graph, size_t threads = 0) {
+    using mst_detail::NO_ARC;
+    using mst_detail::NO_VERTEX;
+    mst_detail::require_undirected(graph);
+    threads = threads == 0 ? default_thread_count() : threads;
+    size_t n = graph.vertex_count();
+    const auto& offsets = graph.offsets();
+    const auto& targets = graph.targets();
+
+    ConcurrentDisjointSet sets(n);
+    std::vector<uint32_t> label(n);
+    std::vector<uint64_t> lightest(n);                     // Lightest arc of each vertex leaving its component
+    std::vector<std::atomic<uint32_t>> winner(n);          // Per component root: vertex holding its lightest arc
+    std::vector<uint64_t> chosen(n);                       // Per component root: arc linked this round
+    std::vector<uint64_t> tree;
+
+    // Key of the edge behind arc a leaving vertex x, in the file's strict total order
+    auto key = [&](uint32_t x, uint64_t a) {
+        return std::make_tuple(graph.weight(a), std::min(x, targets[a]), std::max(x, targets[a]));
+    };
+
+    while (true) {
+        parallel_for(0, n, [&](size_t v) {
+            label[v] = sets.find(static_cast<uint32_t>(v));
+            winner[v].store(NO_VERTEX, std::memory_order_relaxed);
+            chosen[v] = NO_ARC;
+        }, 4096, threads);
+
+        parallel_for(0, n, [&](size_t v) {
+            uint32_t x = static_cast<uint32_t>(v);
+            uint64_t best = NO_ARC;
+            for (uint64_t arc = offsets[v]; arc < offsets[v + 1]; ++arc) {
+                if (label[targets[arc]] != label[v] && (best == NO_ARC || key(x, arc) < key(x, best))) {
+                    best = arc;
+                }
+            }
+            lightest[v] = best;
+            if (best == NO_ARC) {
+                return;
+            }
+            auto& slot = winner[label[v]];
+            // Release/acquire so that lightest[current] is visible to whoever reads current
+            uint32_t current = slot.load(std::memory_order_acquire);
+            while (current == NO_VERTEX || key(x, best) < key(current, lightest[current])) {
+                if (slot.compare_exchange_weak(current, x, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    break;
+                }
+            }
+        }, 1024, threads);
+
+        // The chosen edges form a forest over the components, except that two components
+        // may pick the same edge; unite() succeeds for only one of them
+        std::atomic<bool> linked(false);
+        parallel_for(0, n, [&](size_t r) {
+            uint32_t x = winner[r].load(std::memory_order_relaxed);
+            if (x != NO_VERTEX && sets.unite(x, targets[lightest[x]])) {
+                chosen[r] = lightest[x];
+                linked.store(true, std::memory_order_relaxed);
+            }
+        }, 4096, threads);
+        if (!linked.load()) {
+            break;
+        }
+
+        for (size_t r = 0; r < n; ++r) {
+            if (chosen[r] == NO_ARC) {
+                continue;
+            }
+            // Report the edge as its first lightest arc stored at the smaller endpoint
+            uint64_t arc = chosen[r];
+            uint32_t source = static_cast<uint32_t>(std::upper_bound(offsets.begin(), offsets.end(), arc) -
+                                                    offsets.begin() - 1);
+            uint32_t u = std::min(source, targets[arc]);
+            uint32_t v = std::max(source, targets[arc]);
+            int weight = graph.weight(arc);
+            uint64_t canonical = static_cast<uint64_t>(
+                std::lower_bound(targets.begin() + static_cast<std::ptrdiff_t>(offsets[u]),
+                                 targets.begin() + static_cast<std::ptrdiff_t>(offsets[u + 1]), v) - targets.begin());
+            while (graph.weight(canonical) != weight) {
+                canonical++;
+            }
+            tree.push_back(canonical);
+        }
+    }
+    return mst_detail::finish(graph, std::move(tree));
+}
+
+/**
+ * @brief Check that a forest is a minimum spanning forest of a graph
+ * @param graph The graph (undirected)
+ * @param forest The forest to check
+ * @return true if the arcs are valid, acyclic, span every component, and match the
+ *         reference total weight
+ */
+inline bool verify_spanning_forest(const CSRGraph& graph, const SpanningForest& forest) {
+    const auto& offsets = graph.offsets();
+    DisjointSet sets(graph.vertex_count());
+    int64_t weight = 0;
+    for (uint64_t arc : forest.arcs) {
+        if (arc >= graph.arc_count()) {
+            return false;
+        }
+        uint32_t source = static_cast<uint32_t>(std::upper_bound(offsets.begin(), offsets.end(), arc) -
+                                                offsets.begin() - 1);
+        if (!sets.unite(source, graph.targets()[arc])) {
+            return false;
+        }
+        weight += graph.weight(arc);
+    }
+    SpanningForest reference = minimum_spanning_forest_reference(graph);
+    return sets.set_count() == reference.trees && forest.trees == reference.trees &&
+           weight == forest.total_weight && weight == reference.total_weight;
+}
+
+/**
+ * @brief Minimum spanning forest of a graph snapshot, as edges between original keys
+ * @param snapshot The snapshot of an undirected Graph<T>
+ * @param threads Worker threads (0 means default_thread_count())
+ * @return The total weight and the (key, key, weight) tree edges
+ * @throw std::invalid_argument if the graph is directed
+ */
+template<typename T>
+std::pair<int64_t, std::vector<std::tuple<T, T, int>>> minimum_spanning_forest(const GraphSnapshot<T>& snapshot,
+                                                                                size_t threads = 0) {
+    const CSRGraph& graph = snapshot.csr();
+    SpanningForest forest = minimum_spanning_forest_boruvka(graph, threads);
+    const auto& offsets = graph.offsets();
+    std::vector<std::tuple<T, T, int>> edges;
+    edges.reserve(forest.arcs.size());
+    for (uint64_t arc : forest.arcs) {
+        uint32_t source = static_cast<uint32_t>(std::upper_bound(offsets.begin(), offsets.end(), arc) -
+                                                offsets.begin() - 1);
+        edges.emplace_back(snapshot.key_of(source), snapshot.key_of(graph.targets()[arc]), graph.weight(arc));
+    }
+    return {forest.total_weight, std::move(edges)};
+}
+
+#endif // MST_HPP
@@ -0,0 +1,256 @@
+/**
+ * @file multi_source_bfs.hpp
+ * @brief Bit-parallel multi-source BFS (MS-BFS): up to 64 * Words traversals share every adjacency scan
+ *
+ * Following Then et al., "The More the Merrier: Efficient Multi-Source Graph Traversal"
+ * (VLDB 2015), every vertex carries three bit masks with one bit per source: seen
+ * (the source has reached the vertex), visit (the vertex is in that source's current
+ * frontier) and next (it joins the frontier in the next level). Expanding a vertex ORs
+ * its visit mask into the next masks of its neighbors, so one scan of a neighbor list
+ * advances every BFS that has the vertex in its frontier at once. Masks are Words
+ * 64-bit words (Words = 8 gives 512 sources); the per-word loops have a constant trip
+ * count and compile to vector instructions.
+ *
+ * Each level is expanded in parallel, either top-down from the frontier (atomic ORs into
+ * the neighbors' next masks) or, once the frontier's arcs exceed 1/14 of all arcs,
+ * bottom-up: every vertex not yet seen by all sources ORs the visit masks of its
+ * in-neighbors, which needs no atomics. Sources beyond 64 * Words are processed in
+ * consecutive batches.
+ *
+ * The gain depends on how much the traversals overlap. On small-world graphs the
+ * frontiers of all sources merge within a few levels, and 64 sources cost little more
+ * than one BFS (over 10x the throughput of repeated single runs). On high-diameter
+ * graphs such as road networks, distant sources rarely share a frontier, and the cost
+ * is close to that of separate runs.
+ *
+ * Time Complexity: O(ceil(S / (64 * Words)) * (V + E) * D) worst case for S sources and
+ *                  D levels; typically each batch costs a few single BFS traversals
+ *
+ * Space Complexity: O(V * Words) per batch, plus O(S * V) for a distance matrix
+ */
+
+#ifndef MULTI_SOURCE_BFS_HPP
+#define MULTI_SOURCE_BFS_HPP
+
+#include <bit>
+#include <atomic>
+#include <vector>
+#include <limits>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+#include "csr_graph.hpp"
+#include "../other/parallel_for.hpp"
+
+/**
+ * @brief Hop distances from several sources, one row per source
+ */
+struct MultiSourceDistances {
+    static constexpr uint32_t UNREACHABLE = std::numeric_limits<uint32_t>::max();
+
+    std::vector<uint32_t> sources;
+    size_t vertex_count = 0;
+    std::vector<uint32_t> distance;     // distance[i * vertex_count + v] is the distance from sources[i] to v
+
+    /**
+     * @brief Get the distance from the i-th source to a vertex (UNREACHABLE if not reachable)
+     */
+    uint32_t at(size_t source_index, uint32_t vertex) const {
+        return distance[source_index * vertex_count + vertex];
+    }
+};
+
+namespace multi_source_bfs_detail {
+
+// Beamer's switching threshold: go bottom-up once the frontier has more than arcs / ALPHA arcs
+constexpr uint64_t ALPHA = 14;
+
+template<size_t Words, typename Callback>
+void run_batch(const CSRGraph& graph, const CSRGraph& in_graph, const uint32_t* sources, size_t count, size_t base,
+               Callback& callback, size_t threads) {
+    size_t n = graph.vertex_count();
+    std::vector<uint64_t> seen(n * Words, 0);
+    std::vector<uint64_t> visit(n * Words, 0);
+    std::vector<uint64_t> next(n * Words, 0);
+    std::vector<uint8_t> queued(n, 0);
+
+    // Bits of the sources in this batch; the rest of the last word stays clear
+    uint64_t full[Words];
+    for (size_t k = 0; k < Words; ++k) {
+        size_t used = std::min<size_t>(64, count > k * 64 ? count - k * 64 : 0);
+        full[k] = used == 64 ? ~uint64_t(0) : (uint64_t(1) << used) - 1;
+    }
+
+    std::vector<uint32_t> frontier;
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t v = sources[i];
+        uint64_t* mask = &seen[size_t(v) * Words];
+        if (!queued[v]) {
+            queued[v] = 1;
+            frontier.push_back(v);
+        }
+        mask[i / 64] |= uint64_t(1) << (i % 64);
+        visit[size_t(v) * Words + i / 64] |= uint64_t(1) << (i % 64);
+        callback(base + i, v, uint32_t(0));
+    }
+    for (uint32_t v : frontier) {
+        queued[v] = 0;
+    }
+
+    std::vector<std::vector<uint32_t>> found(std::max<size_t>(1, threads));
+    uint64_t arcs = graph.arc_count();
+    for (uint32_t level = 1; !frontier.empty(); ++level) {
+        uint64_t frontier_arcs = 0;
+        for (uint32_t v : frontier) {
+            frontier_arcs += graph.degree(v);
+        }
+
+        if (frontier_arcs * ALPHA > arcs) {
+            // Bottom-up: gather from in-neighbors, each vertex written by one thread only
+            parallel_for_blocks(0, n, 1024, [&](size_t lo, size_t hi, size_t worker) {
+                for (size_t v = lo; v < hi; ++v) {
+                    const uint64_t* own = &seen[v * Words];
+                    bool complete = true;
+                    for (size_t k = 0; k < Words; ++k) {
+                        complete = complete && own[k] == full[k];
+                    }
+                    if (complete) {
+                        continue;
+                    }
+                    uint64_t gathered[Words] = {};
+                    for (uint32_t u : in_graph.neighbors(static_cast<uint32_t>(v))) {
+                        const uint64_t* from = &visit[size_t(u) * Words];
+                        for (size_t k = 0; k < Words; ++k) {
+                            gathered[k] |= from[k];
+                        }
+                    }
+                    uint64_t any = 0;
+                    for (size_t k = 0; k < Words; ++k) {
+                        next[v * Words + k] = gathered[k] & ~own[k];
+                        any |= next[v * Words + k];
+                    }
+                    if (any != 0) {
+                        found[worker].push_back(static_cast<uint32_t>(v));
+                    }
+                }
+            }, threads);
+        } else {
+            // Top-down: scatter into out-neighbors; the first thread to touch a vertex queues it.
+            // A lone worker can skip the atomic read-modify-writes.
+            bool concurrent = threads > 1 && frontier.size() > 64;
+            parallel_for_blocks(0, frontier.size(), 64, [&](size_t lo, size_t hi, size_t worker) {
+                for (size_t i = lo; i < hi; ++i) {
+                    const uint64_t* from = &visit[size_t(frontier[i]) * Words];
+                    for (uint32_t w : graph.neighbors(frontier[i])) {
+                        uint64_t any = 0;
+                        for (size_t k = 0; k < Words; ++k) {
+                            uint64_t bits = from[k] & ~seen[size_t(w) * Words + k];
+                            if (bits != 0) {
+                                if (concurrent) {
+                                    std::atomic_ref<uint64_t>(next[size_t(w) * Words + k])
+                                        .fetch_or(bits, std::memory_order_relaxed);
+                                } else {
+                                    next[size_t(w) * Words + k] |= bits;
+                                }
+                                any |= bits;
+                            }
+                        }
+                        if (any == 0) {
+                            continue;
+                        }
+                        bool first = concurrent
+                            ? std::atomic_ref<uint8_t>(queued[w]).exchange(1, std::memory_order_relaxed) == 0
+                            : std::exchange(queued[w], uint8_t(1)) == 0;
+                        if (first) {
+                            found[worker].push_back(w);
+                        }
+                    }
+                }
+            }, threads);
+        }
+
+        for (uint32_t v : frontier) {
+            std::fill_n(&visit[size_t(v) * Words], Words, 0);
+        }
+        frontier.clear();
+        for (auto& list : found) {
+            frontier.insert(frontier.end(), list.begin(), list.end());
+            list.clear();
+        }
+
+        // Publish the new level; a vertex is handled by exactly one thread
+        parallel_for(0, frontier.size(), [&](size_t i) {
+            uint32_t v = frontier[i];
+            queued[v] = 0;
+            for (size_t k = 0; k < Words; ++k) {
+                uint64_t bits = next[size_t(v) * Words + k];
+                next[size_t(v) * Words + k] = 0;
+                seen[size_t(v) * Words + k] |= bits;
+                visit[size_t(v) * Words + k] = bits;
+                for (; bits != 0; bits &= bits - 1) {
+                    callback(base + k * 64 + static_cast<size_t>(std::countr_zero(bits)), v, level);
+                }
+            }
+        }, 256, threads);
+    }
+}
+
+} // namespace multi_source_bfs_detail
+
+/**
+ * @brief Run a BFS from every source at once, reporting each (source, vertex) pair reached
+ * @tparam Words 64-bit words per vertex mask: 1 runs 64 sources per batch, 8 runs 512
+ * @param graph The graph
+ * @param sources Source vertex IDs (duplicates allowed, each gets its own traversal)
+ * @param callback Called as callback(source_index, vertex, distance) once per reached pair;
+ *                 calls come from several threads, but never concurrently for the same vertex
+ * @param threads Worker threads (0 means default_thread_count())
+ * @throw std::out_of_range if a source ID is out of range
+ */
+template<size_t Words = 1, typename Callback>
+void multi_source_bfs(const CSRGraph& graph, const std::vector<uint32_t>& sources, Callback callback,
+                      size_t threads = 0) {
+    static_assert(Words >= 1, "A mask needs at least one word");
+    for (uint32_t s : sources) {
+        if (s >= graph.vertex_count()) {
+            throw std::out_of_range("Source vertex ID is out of range");
+        }
+    }
+    threads = threads == 0 ? default_thread_count() : threads;
+    CSRGraph transposed = graph.is_directed() ? graph.transpose() : CSRGraph();
+    const CSRGraph& in_graph = graph.is_directed() ? transposed : graph;
+    for (size_t base = 0; base < sources.size(); base += 64 * Words) {
+        size_t count = std::min(sources.size() - base, 64 * Words);
+        multi_source_bfs_detail::run_batch<Words>(graph, in_graph, sources.data() + base, count, base, callback,
+                                                  threads);
+    }
+}
+
+/**
+ * @brief Compute the hop distance from every source to every vertex
+ * @param graph The graph
+ * @param sources Source vertex IDs
+ * @param threads Worker threads (0 means default_thread_count())
+ * @return One row of distances per source
+ * @throw std::out_of_range if a source ID is out of range
+ */
+inline MultiSourceDistances multi_source_distances(const CSRGraph& graph, const std::vector<uint32_t>& sources,
+                                                   size_t threads = 0) {
+    MultiSourceDistances result;
+    result.sources = sources;
+    result.vertex_count = graph.vertex_count();
+    result.distance.assign(sources.size() * graph.vertex_count(), MultiSourceDistances::UNREACHABLE);
+    auto record = [&](size_t source_index, uint32_t vertex, uint32_t distance) {
+        result.distance[source_index * result.vertex_count + vertex] = distance;
+    };
+    if (sources.size() > 64) {
+        multi_source_bfs<8>(graph, sources, record, threads);
+    } else {
+        multi_source_bfs<1>(graph, sources, record, threads);
+    }
+    return result;
+}
+
+#endif // MULTI_SOURCE_BFS_HPP
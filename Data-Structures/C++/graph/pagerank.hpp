@@ -0,0 +1,357 @@
+/**
+ * @file pagerank.hpp
+ * @brief Iterative vertex programs (pull SpMV and push deltas) and PageRank on a CSRGraph
+ *
+ * run_pull() is a generic synchronous kernel: every iteration each vertex gathers the
+ * contributions of its in-neighbors (a sparse matrix-vector product) and applies an
+ * update. It is a template over the graph type, which needs vertex_count(), arc_count()
+ * and for_each_neighbor(v, f(neighbor, weight)); CSRGraph and CompressedGraph both work. Vertices are processed in parallel blocks; there are no atomics
+ * because every vertex is written by exactly one thread. Iteration stops when the L1
+ * change of the values drops below the tolerance.
+ *
+ * A program passed to run_pull() provides:
+ * - static constexpr bool weighted: multiply contributions by the edge weight
+ * - void begin_iteration(const std::vector<double>& values): per-iteration setup
+ * - double contribution(uint32_t u, double value): what u sends along each out-arc
+ * - double apply(uint32_t v, double gathered, double old): the new value of v
+ *
+ * pagerank() and personalized_pagerank() are built on it. pagerank_push() solves the
+ * same equations by pushing residuals from a frontier of vertices whose residual is
+ * still large, which touches only the affected region when updates are sparse (e.g.
+ * personalized PageRank from a few seeds).
+ *
+ * Time Complexity:
+ * - Pull iteration: O(V + E) work
+ * - Push: O(E) work per round over the active frontier
+ *
+ * Space Complexity: O(V), plus O(E) for the transpose of a directed graph
+ */
+
+#ifndef PAGERANK_HPP
+#define PAGERANK_HPP
+
+#include <vector>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+#include "csr_graph.hpp"
+#include "../other/parallel_for.hpp"
+
+/**
+ * @brief Stopping criteria and parallelism for the iterative kernels
+ */
+struct IterationOptions {
+    size_t max_iterations = 100;
+    double tolerance = 1e-6;     // Pull: L1 change per iteration; push: residual left per vertex, relative to a seed's
+    size_t threads = 0;          // Worker threads (0 means default_thread_count())
+};
+
+/**
+ * @brief Values and statistics returned by the iterative kernels
+ */
+struct IterationResult {
+    std::vector<double> values;
+    size_t iterations = 0;
+    double residual = 0.0;           // Last L1 change (pull) or residual mass left (push)
+    bool converged = false;
+    uint64_t edges_processed = 0;    // Arcs scanned over all iterations, for throughput reporting
+};
+
+/**
+ * @brief Run a synchronous pull-based vertex program until convergence
+ * @param in_graph Graph whose neighbor lists are the in-neighbors of each vertex
+ *                 (the graph itself if undirected, its transpose() if directed)
+ *                 of any type with the interface in the file comment
+ * @param program The vertex program (see the file comment)
+ * @param initial The initial value of every vertex
+ * @param options Stopping criteria and thread count
+ * @return The final values and iteration statistics
+ */
+template<typename Graph, typename Program>
+IterationResult run_pull(const Graph& in_graph, Program& program, std::vector<double> initial,
+                         const IterationOptions& options = {}) {
+    size_t n = in_graph.vertex_count();
+    if (initial.size() != n) {
+        throw std::invalid_argument("Initial values must have one entry per vertex");
+    }
+    size_t threads = options.threads == 0 ? default_thread_count() : options.threads;
+
+    IterationResult result;
+    result.values = std::move(initial);
+    std::vector<double> next(n);
+    std::vector<double> contribution(n);
+    std::vector<double> partial(threads);
+
+    while (result.iterations < options.max_iterations) {
+        program.begin_iteration(result.values);
+        parallel_for(0, n, [&](size_t u) {
+            contribution[u] = program.contribution(static_cast<uint32_t>(u), result.values[u]);
+        }, 4096, threads);
+
+        std::fill(partial.begin(), partial.end(), 0.0);
+        parallel_for_blocks(0, n, 2048, [&](size_t lo, size_t hi, size_t worker) {
+            double change = 0.0;
+            for (size_t v = lo; v < hi; ++v) {
+                double gathered = 0.0;
+                in_graph.for_each_neighbor(static_cast<uint32_t>(v), [&](uint32_t u, int weight) {
+                    if constexpr (Program::weighted) {
+                        gathered += contribution[u] * weight;
+                    } else {
+                        gathered += contribution[u];
+                    }
+                });
+                next[v] = program.apply(static_cast<uint32_t>(v), gathered, result.values[v]);
+                change += std::fabs(next[v] - result.values[v]);
+            }
+            partial[worker] += change;
+        }, threads);
+
+        result.values.swap(next);
+        result.iterations++;
+        result.edges_processed += in_graph.arc_count();
+        result.residual = 0.0;
+        for (double change : partial) {
+            result.residual += change;
+        }
+        if (result.residual < options.tolerance) {
+            result.converged = true;
+            break;
+        }
+    }
+    return result;
+}
+
+namespace pagerank_detail {
+
+// PR = (1 - d) * t + d * (P^T PR + dangling * t) for teleport distribution t
+template<typename Graph>
+class PageRankProgram {
+private:
+    const Graph& graph;
+    const std::vector<double>& teleport;   // Empty means uniform
+    double damping;
+    double dangling = 0.0;
+
+public:
+    static constexpr bool weighted = false;
+
+    PageRankProgram(const Graph& graph, const std::vector<double>& teleport, double damping)
+        : graph(graph), teleport(teleport), damping(damping) {}
+
+    void begin_iteration(const std::vector<double>& values) {
+        dangling = 0.0;
+        for (uint32_t u = 0; u < values.size(); ++u) {
+            if (graph.degree(u) == 0) {
+                dangling += values[u];
+            }
+        }
+    }
+
+    double contribution(uint32_t u, double value) const {
+        size_t degree = graph.degree(u);
+        return degree == 0 ? 0.0 : value / static_cast<double>(degree);
+    }
+
+    double apply(uint32_t v, double gathered, double) const {
+        double t = teleport.empty() ? 1.0 / static_cast<double>(graph.vertex_count()) : teleport[v];
+        return (1.0 - damping) * t + damping * (gathered + dangling * t);
+    }
+};
+
+inline std::vector<double> seed_distribution(size_t n, const std::vector<uint32_t>& seeds) {
+    if (seeds.empty()) {
+        throw std::invalid_argument("Personalized PageRank needs at least one seed");
+    }
+    std::vector<double> teleport(n, 0.0);
+    for (uint32_t seed : seeds) {
+        if (seed >= n) {
+            throw std::out_of_range("Seed vertex ID is out of range");
+        }
+        teleport[seed] += 1.0 / static_cast<double>(seeds.size());
+    }
+    return teleport;
+}
+
+template<typename Graph>
+IterationResult pull(const Graph& graph, const Graph& in_graph, const std::vector<double>& teleport,
+                     double damping, const IterationOptions& options) {
+    size_t n = graph.vertex_count();
+    PageRankProgram<Graph> program(graph, teleport, damping);
+    std::vector<double> initial = teleport.empty() ? std::vector<double>(n, n ? 1.0 / static_cast<double>(n) : 0.0)
+                                                   : teleport;
+    return run_pull(in_graph, program, std::move(initial), options);
+}
+
+} // namespace pagerank_detail
+
+/**
+ * @brief Compute PageRank with the pull kernel
+ * @param graph The graph (for a directed graph the transpose is built internally)
+ * @param damping Probability of following an arc rather than teleporting
+ * @param options Stopping criteria and thread count
+ * @return PageRank scores summing to 1; dangling vertices teleport uniformly
+ */
+inline IterationResult pagerank(const CSRGraph& graph, double damping = 0.85, const IterationOptions& options = {}) {
+    if (!graph.is_directed()) {
+        return pagerank_detail::pull(graph, graph, {}, damping, options);
+    }
+    CSRGraph transposed = graph.transpose();
+    return pagerank_detail::pull(graph, transposed, {}, damping, options);
+}
+
+/**
+ * @brief Compute PageRank with a precomputed transpose (for repeated runs on a directed graph)
+ * @param graph The graph
+ * @param transposed graph.transpose()
+ * @param damping Probability of following an arc rather than teleporting
+ * @param options Stopping criteria and thread count
+ * @return PageRank scores summing to 1
+ */
+inline IterationResult pagerank(const CSRGraph& graph, const CSRGraph& transposed, double damping,
+                                const IterationOptions& options = {}) {
+    return pagerank_detail::pull(graph, transposed, {}, damping, options);
+}
+
+/**
+ * @brief Compute personalized PageRank (random walk with restart to a seed set) with the pull kernel
+ * @param graph The graph
+ * @param seeds Vertices the walk restarts from, uniformly
+ * @param damping Probability of following an arc rather than restarting
+ * @param options Stopping criteria and thread count
+ * @return Scores summing to 1
+ * @throw std::invalid_argument if there are no seeds
+ */
+inline IterationResult personalized_pagerank(const CSRGraph& graph, const std::vector<uint32_t>& seeds,
+                                             double damping = 0.85, const IterationOptions& options = {}) {
+    std::vector<double> teleport = pagerank_detail::seed_distribution(graph.vertex_count(), seeds);
+    if (!graph.is_directed()) {
+        return pagerank_detail::pull(graph, graph, teleport, damping, options);
+    }
+    CSRGraph transposed = graph.transpose();
+    return pagerank_detail::pull(graph, transposed, teleport, damping, options);
+}
+
+/**
+ * @brief Compute (personalized) PageRank by pushing residuals from an active frontier
+ * @param graph The graph (out-arcs are used directly, no transpose is needed)
+ * @param seeds Restart vertices; empty means ordinary PageRank with uniform teleport
+ * @param damping Probability of following an arc rather than teleporting
+ * @param options A vertex is pushed while its residual exceeds tolerance times the smallest
+ *                initial residual (1 - damping) * teleport probability, so the threshold
+ *                scales with 1 / n for uniform teleport and every teleport vertex is seeded
+ * @return Scores; their L1 error is at most residual / (1 - damping)
+ */
+inline IterationResult pagerank_push(const CSRGraph& graph, const std::vector<uint32_t>& seeds = {},
+                                     double damping = 0.85, const IterationOptions& options = {}) {
+    size_t n = graph.vertex_count();
+    size_t threads = options.threads == 0 ? default_thread_count() : options.threads;
+    const auto& offsets = graph.offsets();
+    const auto& targets = graph.targets();
+
+    // Teleport distribution as a sparse (vertex, probability) list
+    std::vector<std::pair<uint32_t, double>> teleport;
+    if (seeds.empty()) {
+        for (uint32_t v = 0; v < n; ++v) {
+            teleport.emplace_back(v, 1.0 / static_cast<double>(n));
+        }
+    } else {
+        std::vector<double> dense = pagerank_detail::seed_distribution(n, seeds);
+        for (uint32_t v = 0; v < n; ++v) {
+            if (dense[v] > 0.0) {
+                teleport.emplace_back(v, dense[v]);
+            }
+        }
+    }
+
+    std::vector<std::atomic<double>> residual(n);
+    std::vector<std::atomic<bool>> queued(n);
+    for (size_t v = 0; v < n; ++v) {
+        residual[v].store(0.0, std::memory_order_relaxed);
+        queued[v].store(false, std::memory_order_relaxed);
+    }
+
+    // Relative to the smallest starting residual; an absolute threshold would seed
+    // nothing once (1 - damping) / n drops below it
+    double smallest = 1.0;
+    for (const auto& entry : teleport) {
+        smallest = std::min(smallest, entry.second);
+    }
+    double threshold = options.tolerance * (1.0 - damping) * smallest;
+
+    IterationResult result;
+    result.values.assign(n, 0.0);
+    std::vector<uint32_t> frontier;
+    for (const auto& [v, probability] : teleport) {
+        residual[v].store((1.0 - damping) * probability, std::memory_order_relaxed);
+        if ((1.0 - damping) * probability > threshold) {
+            queued[v].store(true, std::memory_order_relaxed);
+            frontier.push_back(v);
+        }
+    }
+
+    std::vector<std::vector<uint32_t>> next(threads);
+    std::vector<double> dangling(threads);
+    std::vector<uint64_t> scanned(threads);
+
+    auto add_residual = [&](uint32_t v, double amount, std::vector<uint32_t>& out) {
+        double before = residual[v].fetch_add(amount, std::memory_order_relaxed);
+        if (before + amount > threshold && !queued[v].exchange(true, std::memory_order_relaxed)) {
+            out.push_back(v);
+        }
+    };
+
+    while (!frontier.empty() && result.iterations < options.max_iterations) {
+        std::fill(dangling.begin(), dangling.end(), 0.0);
+        parallel_for_blocks(0, frontier.size(), 256, [&](size_t lo, size_t hi, size_t worker) {
+            for (size_t i = lo; i < hi; ++i) {
+                uint32_t u = frontier[i];
+                // Clear the flag first so that pushes arriving from now on re-queue u
+                queued[u].store(false, std::memory_order_relaxed);
+                double mass = residual[u].exchange(0.0, std::memory_order_relaxed);
+                result.values[u] += mass;
+                size_t degree = graph.degree(u);
+                if (degree == 0) {
+                    dangling[worker] += damping * mass;
+                    continue;
+                }
+                double share = damping * mass / static_cast<double>(degree);
+                for (uint64_t arc = offsets[u]; arc < offsets[u + 1]; ++arc) {
+                    add_residual(targets[arc], share, next[worker]);
+                }
+                scanned[worker] += degree;
+            }
+        }, threads);
+
+        double lost = 0.0;
+        for (double mass : dangling) {
+            lost += mass;
+        }
+        if (lost > 0.0) {
+            for (const auto& [v, probability] : teleport) {
+                add_residual(v, lost * probability, next[0]);
+            }
+        }
+
+        frontier.clear();
+        for (auto& part : next) {
+            frontier.insert(frontier.end(), part.begin(), part.end());
+            part.clear();
+        }
+        result.iterations++;
+    }
+
+    result.converged = frontier.empty();
+    result.residual = 0.0;
+    for (size_t v = 0; v < n; ++v) {
+        result.residual += residual[v].load(std::memory_order_relaxed);
+    }
+    for (uint64_t count : scanned) {
+        result.edges_processed += count;
+    }
+    return result;
+}
+
+#endif // PAGERANK_HPP
@@ -0,0 +1,854 @@
+/**
+ * @file partitioned_graph.hpp
+ * @brief Edge-cut partitioned graphs processed by one worker process per partition (BSP, POSIX)
+ *
+ * A GraphPartition assigns every vertex to one of P parts, either by hashing its ID or
+ * by size-constrained label propagation, which moves each vertex to the part holding
+ * most of its neighbors and so cuts far fewer arcs. A PartitionedGraph then splits the
+ * CSR arrays into one PartitionShard per part. A shard holds only the out-arcs of its
+ * own vertices. Arcs to other parts point at ghost slots, and each ghost records the
+ * owning part and the vertex's local ID there.
+ *
+ * run_bsp() forks one worker process per shard and runs a vertex program in bulk
+ * synchronous supersteps. Messages travel through single-producer single-consumer ring
+ * buffers, one per ordered pair of parts, in a shared anonymous mapping created before
+ * the fork. A sender whose ring is full drains its own incoming rings while it waits, so
+ * two workers filling each other's rings cannot deadlock. Every superstep ends with two
+ * barriers, built on process-shared atomics:
+ * - after the first, all messages of the superstep have been sent; they are drained and
+ *   the per-worker aggregates are summed;
+ * - after the second, everyone has read them, so the next superstep may start sending.
+ * Workers write their final vertex values into a shared result array.
+ *
+ * The driver only depends on the shard and the message rings. Swapping the rings for
+ * sockets, and building each shard in its own process, would extend it to several
+ * machines. bsp_bfs() and bsp_pagerank() are the built-in programs. Messages to the
+ * same ghost are combined on the sending side, so PageRank sends at most one message
+ * per cut (vertex, part) pair and superstep.
+ *
+ * Fork the workers from a single-threaded process: only the calling thread survives fork().
+ *
+ * Time Complexity:
+ * - Hash partition: O(V + E); label propagation: O(iterations * (E + V * P))
+ * - Superstep: O(local V + local E + messages) per worker
+ *
+ * Space Complexity: O(V + E) for the shards, O(P^2 * ring_capacity) shared ring memory
+ */
+
+#ifndef PARTITIONED_GRAPH_HPP
+#define PARTITIONED_GRAPH_HPP
+
+#include <array>
+#include <cmath>
+#include <cerrno>
+#include <chrono>
+#include <atomic>
+#include <limits>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "csr_graph.hpp"
+#include "pagerank.hpp"
+
+/**
+ * @brief Assignment of vertices to parts
+ */
+struct GraphPartition {
+    uint32_t parts = 0;
+    std::vector<uint32_t> owner;                    // Part of every vertex
+    std::vector<uint32_t> local_id;                 // Index of every vertex within its part
+    std::vector<std::vector<uint32_t>> members;     // Vertices of every part, ascending
+    uint64_t cut_arcs = 0;                          // Arcs whose endpoints are in different parts
+
+    /**
+     * @brief Get the largest part size divided by the average part size (1.0 is perfectly balanced)
+     */
+    double imbalance() const {
+        size_t largest = 0;
+        for (const auto& part : members) {
+            largest = std::max(largest, part.size());
+        }
+        return owner.empty() ? 1.0 : static_cast<double>(largest) * parts / static_cast<double>(owner.size());
+    }
+};
+
+namespace partition_detail {
+
+inline uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+inline void require_parts(uint32_t parts) {
+    if (parts == 0) {
+        throw std::invalid_argument("A partition needs at least one part");
+    }
+}
+
+} // namespace partition_detail
+
+/**
+ * @brief Complete a partition from the owner of every vertex
+ * @param graph The graph
+ * @param owner The part of every vertex, each below parts
+ * @param parts The number of parts
+ * @return The partition with member lists, local IDs and the cut size
+ * @throw std::invalid_argument if the sizes do not match or an owner is out of range
+ */
+inline GraphPartition make_partition(const CSRGraph& graph, std::vector<uint32_t> owner, uint32_t parts) {
+    partition_detail::require_parts(parts);
+    if (owner.size() != graph.vertex_count()) {
+        throw std::invalid_argument("Owner array does not match the vertex count");
+    }
+    GraphPartition partition;
+    partition.parts = parts;
+    partition.members.resize(parts);
+    partition.local_id.resize(owner.size());
+    for (uint32_t v = 0; v < owner.size(); ++v) {
+        if (owner[v] >= parts) {
+            throw std::invalid_argument("Owner is out of range");
+        }
+        partition.local_id[v] = static_cast<uint32_t>(partition.members[owner[v]].size());
+        partition.members[owner[v]].push_back(v);
+    }
+    for (uint32_t v = 0; v < owner.size(); ++v) {
+        for (uint32_t w : graph.neighbors(v)) {
+            partition.cut_arcs += owner[v] != owner[w];
+        }
+    }
+    partition.owner = std::move(owner);
+    return partition;
+}
+
+/**
+ * @brief Assign vertices to parts by a hash of their ID (balanced, but ignores locality)
+ * @param graph The graph
+ * @param parts The number of parts
+ * @return The partition
+ * @throw std::invalid_argument if parts is 0
+ */
+inline GraphPartition hash_partition(const CSRGraph& graph, uint32_t parts) {
+    partition_detail::require_parts(parts);
+    std::vector<uint32_t> owner(graph.vertex_count());
+    for (uint32_t v = 0; v < owner.size(); ++v) {
+        owner[v] = static_cast<uint32_t>(partition_detail::mix(v) % parts);
+    }
+    return make_partition(graph, std::move(owner), parts);
+}
+
+/**
+ * @brief Assign vertices to parts by size-constrained label propagation
+ *
+ * Starting from the hash partition, every round visits the vertices in random order
+ * and moves each to the part that holds most of its neighbors (out-arcs), provided that
+ * part stays below (1 + slack) times the average size. Stops early when a round moves
+ * fewer than 0.1% of the vertices.
+ *
+ * @param graph The graph
+ * @param parts The number of parts
+ * @param rounds Maximum number of rounds
+ * @param slack Allowed imbalance above the average part size
+ * @param seed Seed for the visiting order
+ * @return The partition
+ * @throw std::invalid_argument if parts is 0 or slack is negative
+ */
+inline GraphPartition label_propagation_partition(const CSRGraph& graph, uint32_t parts, size_t rounds = 10,
+                                                  double slack = 0.05, uint64_t seed = 1) {
+    partition_detail::require_parts(parts);
+    if (slack < 0.0) {
+        throw std::invalid_argument("Slack must be non-negative");
+    }
+    size_t n = graph.vertex_count();
+    std::vector<uint32_t> owner = hash_partition(graph, parts).owner;
+    std::vector<size_t> size(parts, 0);
+    for (uint32_t part : owner) {
+        size[part]++;
+    }
+    size_t capacity = static_cast<size_t>(std::ceil(static_cast<double>(n) / parts * (1.0 + slack)));
+
+    std::vector<uint32_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::mt19937_64 rng(seed);
+    std::vector<uint32_t> count(parts, 0);
+    std::vector<uint32_t> seen;
+    for (size_t round = 0; round < rounds; ++round) {
+        std::shuffle(order.begin(), order.end(), rng);
+        size_t moved = 0;
+        for (uint32_t v : order) {
+            for (uint32_t w : graph.neighbors(v)) {
+                if (count[owner[w]]++ == 0) {
+                    seen.push_back(owner[w]);
+                }
+            }
+            uint32_t current = owner[v];
+            uint32_t best = current;
+            for (uint32_t part : seen) {
+                if (count[part] > count[best] && size[part] < capacity) {
+                    best = part;
+                }
+            }
+            for (uint32_t part : seen) {
+                count[part] = 0;
+            }
+            seen.clear();
+            if (best != current) {
+                size[current]--;
+                size[best]++;
+                owner[v] = best;
+                moved++;
+            }
+        }
+        if (moved * 1000 < n) {
+            break;
+        }
+    }
+    return make_partition(graph, std::move(owner), parts);
+}
+
+/**
+ * @brief The vertices of one part and their out-arcs
+ */
+struct PartitionShard {
+    uint32_t part = 0;
+    std::vector<uint32_t> vertices;     // Global IDs of the local vertices, ascending
+    std::vector<uint64_t> offsets;      // Local CSR over the local vertices
+    std::vector<uint32_t> slots;        // Arc targets: local ID if below vertices.size(), else ghost + vertices.size()
+    std::vector<uint32_t> ghost_owner;  // Part owning each ghost
+    std::vector<uint32_t> ghost_local;  // Local ID of each ghost in its owning part
+
+    size_t vertex_count() const {
+        return vertices.size();
+    }
+
+    size_t ghost_count() const {
+        return ghost_owner.size();
+    }
+
+    uint64_t degree(uint32_t local) const {
+        return offsets[local + 1] - offsets[local];
+    }
+};
+
+/**
+ * @class PartitionedGraph
+ * @brief A graph split into per-part shards, ready for run_bsp()
+ */
+class PartitionedGraph {
+private:
+    GraphPartition partition_data;
+    std::vector<PartitionShard> shard_data;
+    size_t vertices = 0;
+    uint64_t arcs = 0;
+
+public:
+    /**
+     * @brief Split a graph into shards
+     * @param graph The graph
+     * @param partition A partition of graph
+     * @throw std::invalid_argument if the partition does not match the graph
+     */
+    PartitionedGraph(const CSRGraph& graph, GraphPartition partition)
+        : partition_data(std::move(partition)), vertices(graph.vertex_count()), arcs(graph.arc_count()) {
+        if (partition_data.owner.size() != vertices) {
+            throw std::invalid_argument("Partition does not match the graph");
+        }
+        shard_data.resize(partition_data.parts);
+        std::vector<uint32_t> ghost_of(vertices, UINT32_MAX);
+        for (uint32_t p = 0; p < partition_data.parts; ++p) {
+            PartitionShard& shard = shard_data[p];
+            shard.part = p;
+            shard.vertices = partition_data.members[p];
+            shard.offsets.assign(shard.vertices.size() + 1, 0);
+            uint32_t local_count = static_cast<uint32_t>(shard.vertices.size());
+            std::vector<uint32_t> ghosts;
+            for (uint32_t i = 0; i < local_count; ++i) {
+                for (uint32_t w : graph.neighbors(shard.vertices[i])) {
+                    if (partition_data.owner[w] == p) {
+                        shard.slots.push_back(partition_data.local_id[w]);
+                        continue;
+                    }
+                    if (ghost_of[w] == UINT32_MAX) {
+                        ghost_of[w] = static_cast<uint32_t>(ghosts.size());
+                        ghosts.push_back(w);
+                        shard.ghost_owner.push_back(partition_data.owner[w]);
+                        shard.ghost_local.push_back(partition_data.local_id[w]);
+                    }
+                    shard.slots.push_back(local_count + ghost_of[w]);
+                }
+                shard.offsets[i + 1] = shard.slots.size();
+            }
+            for (uint32_t w : ghosts) {
+                ghost_of[w] = UINT32_MAX;
+            }
+        }
+    }
+
+    const GraphPartition& partition() const {
+        return partition_data;
+    }
+
+    const PartitionShard& shard(uint32_t part) const {
+        return shard_data[part];
+    }
+
+    uint32_t parts() const {
+        return partition_data.parts;
+    }
+
+    size_t vertex_count() const {
+        return vertices;
+    }
+
+    uint64_t arc_count() const {
+        return arcs;
+    }
+};
+
+/**
+ * @brief A message to a vertex of another part
+ */
+struct BSPMessage {
+    uint32_t vertex;    // Local ID in the receiving part
+    uint32_t tag;       // Free for the program
+    double value;
+};
+
+/**
+ * @brief Per-worker values summed over all workers after every superstep
+ */
+using BSPAggregate = std::array<double, 2>;
+
+/**
+ * @brief What run_bsp() returns
+ */
+template<typename Value>
+struct BSPResult {
+    std::vector<Value> values;      // By global vertex ID
+    size_t supersteps = 0;
+    BSPAggregate last{};            // Global aggregate after the last superstep
+};
+
+/**
+ * @brief Options for run_bsp()
+ */
+struct BSPOptions {
+    size_t ring_capacity = 1 << 14;     // Messages per ring (one ring per ordered pair of parts)
+    size_t max_supersteps = 1 << 20;
+};
+
+namespace bsp_detail {
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Process-shared rings need lock-free 64-bit atomics");
+
+// An anonymous MAP_SHARED mapping: shared with processes forked after its creation
+class SharedMemory {
+private:
+    void* address = nullptr;
+    size_t length = 0;
+
+public:
+    explicit SharedMemory(size_t bytes) : length(std::max<size_t>(bytes, 1)) {
+        address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (address == MAP_FAILED) {
+            address = nullptr;
+            throw std::runtime_error("Cannot map shared memory");
+        }
+    }
+
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    ~SharedMemory() {
+        if (address) {
+            ::munmap(address, length);
+        }
+    }
+
+    template<typename U>
+    U* as() const {
+        return static_cast<U*>(address);
+    }
+};
+
+struct alignas(64) RingHeader {
+    std::atomic<uint64_t> head{0};      // Next slot to read, written by the consumer
+    alignas(64) std::atomic<uint64_t> tail{0};      // Next slot to write, written by the producer
+};
+
+struct alignas(64) Control {
+    std::atomic<uint32_t> arrived{0};
+    std::atomic<uint32_t> generation{0};
+    std::atomic<uint32_t> aborted{0};
+};
+
+struct Aborted : std::runtime_error {
+    Aborted() : std::runtime_error("Another BSP worker failed") {}
+};
+
+// Spin, then yield, until done() holds; gives up if a worker failed
+template<typename Done>
+void wait_until(const Control& control, Done done) {
+    for (size_t spins = 0; !done(); ++spins) {
+        if (control.aborted.load(std::memory_order_relaxed)) {
+            throw Aborted();
+        }
+        if (spins > 64) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// Sense-counting barrier; idle() runs while waiting (e.g. draining rings that others still fill)
+template<typename Idle>
+void barrier(Control& control, uint32_t parties, Idle idle) {
+    uint32_t generation = control.generation.load(std::memory_order_acquire);
+    if (control.arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == parties) {
+        control.arrived.store(0, std::memory_order_relaxed);
+        control.generation.fetch_add(1, std::memory_order_acq_rel);
+        return;
+    }
+    wait_until(control, [&] {
+        idle();
+        return control.generation.load(std::memory_order_acquire) != generation;
+    });
+}
+
+// Reap exactly the given workers; the first one that fails raises the abort flag so the
+// others leave their barriers instead of waiting for it forever. Returns false on failure.
+inline bool reap_workers(Control& control, std::vector<pid_t> running) {
+    bool ok = true;
+    while (!running.empty()) {
+        bool reaped = false;
+        for (size_t i = 0; i < running.size();) {
+            int status = 0;
+            pid_t pid = ::waitpid(running[i], &status, WNOHANG);
+            if (pid == 0 || (pid < 0 && errno == EINTR)) {
+                ++i;
+                continue;
+            }
+            // pid < 0 (ECHILD) means someone else reaped the worker, so its outcome is unknown
+            if (pid < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                ok = false;
+                control.aborted.store(1);
+            }
+            running[i] = running.back();
+            running.pop_back();
+            reaped = true;
+        }
+        if (!reaped && !running.empty()) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    return ok;
+}
+
+// What the first worker reports back to the driver
+struct RunStats {
+    std::atomic<uint64_t> supersteps{0};
+    BSPAggregate last{};
+};
+
+// Shared state of one run: control block, aggregates, P * P rings and the results
+template<typename Value>
+struct SharedState {
+    uint32_t parts;
+    size_t capacity;
+    SharedMemory control_memory;
+    SharedMemory ring_memory;
+    SharedMemory result_memory;
+
+    SharedState(uint32_t parts, size_t capacity, size_t vertices)
+        : parts(parts), capacity(capacity),
+          control_memory(sizeof(Control) + parts * sizeof(BSPAggregate)),
+          ring_memory(size_t(parts) * parts * (sizeof(RingHeader) + capacity * sizeof(BSPMessage))),
+          result_memory(vertices * sizeof(Value)) {
+        new (control_memory.as<Control>()) Control();
+        for (size_t r = 0; r < size_t(parts) * parts; ++r) {
+            new (header(r)) RingHeader();
+        }
+    }
+
+    Control& control() const {
+        return *control_memory.as<Control>();
+    }
+
+    BSPAggregate* aggregates() const {
+        return reinterpret_cast<BSPAggregate*>(control_memory.as<char>() + sizeof(Control));
+    }
+
+    RingHeader* header(size_t ring) const {
+        return ring_memory.as<RingHeader>() + ring;
+    }
+
+    BSPMessage* slots(size_t ring) const {
+        char* base = ring_memory.as<char>() + size_t(parts) * parts * sizeof(RingHeader);
+        return reinterpret_cast<BSPMessage*>(base) + ring * capacity;
+    }
+
+    Value* results() const {
+        return result_memory.as<Value>();
+    }
+};
+
+} // namespace bsp_detail
+
+/**
+ * @class BSPOutbox
+ * @brief Sending side of one worker; passed to the program's superstep()
+ */
+template<typename Value>
+class BSPOutbox {
+private:
+    const bsp_detail::SharedState<Value>& state;
+    uint32_t self;
+    std::vector<BSPMessage>& received;  // Messages of this superstep, including those drained while blocked
+    uint64_t sent = 0;
+
+public:
+    BSPOutbox(const bsp_detail::SharedState<Value>& state, uint32_t self, std::vector<BSPMessage>& received)
+        : state(state), self(self), received(received) {}
+
+    /**
+     * @brief Move the messages other workers have already delivered to this one into its inbox
+     */
+    void drain_incoming() {
+        for (uint32_t from = 0; from < state.parts; ++from) {
+            size_t ring = size_t(from) * state.parts + self;
+            auto* header = state.header(ring);
+            const BSPMessage* slots = state.slots(ring);
+            uint64_t head = header->head.load(std::memory_order_relaxed);
+            uint64_t tail = header->tail.load(std::memory_order_acquire);
+            for (; head < tail; ++head) {
+                received.push_back(slots[head % state.capacity]);
+            }
+            header->head.store(head, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief Send a message to a vertex, delivered at the start of the next superstep
+     * @param part The receiving part (may be this worker's own part)
+     * @param vertex The local ID of the vertex in that part
+     * @param value The payload
+     * @param tag Free for the program
+     */
+    void send(uint32_t part, uint32_t vertex, double value, uint32_t tag = 0) {
+        sent++;
+        if (part == self) {
+            received.push_back({vertex, tag, value});
+            return;
+        }
+        size_t ring = size_t(self) * state.parts + part;
+        auto* header = state.header(ring);
+        uint64_t tail = header->tail.load(std::memory_order_relaxed);
+        if (tail - header->head.load(std::memory_order_acquire) == state.capacity) {
+            bsp_detail::wait_until(state.control(), [&] {
+                drain_incoming();
+                return tail - header->head.load(std::memory_order_acquire) < state.capacity;
+            });
+        }
+        state.slots(ring)[tail % state.capacity] = {vertex, tag, value};
+        header->tail.store(tail + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Get the number of messages sent so far by this worker
+     */
+    uint64_t sent_count() const {
+        return sent;
+    }
+};
+
+/**
+ * @brief Run a vertex program on every part in its own process, in bulk synchronous supersteps
+ *
+ * Each worker copies the program, then:
+ * - calls init(shard) once;
+ * - calls superstep(step, shard, global, inbox, outbox) for step = 0, 1, ... where
+ *   inbox holds the messages sent to this part in the previous superstep and global is
+ *   the sum over workers of the BSPAggregate each superstep() returned last time;
+ * - stops after a superstep when done(step, global) holds, which is the same on every worker;
+ * - calls finish(shard, results), which writes the values of its own vertices by global ID.
+ *
+ * @tparam Program The vertex program; Program::Value is the per-vertex result type
+ *                 (trivially copyable)
+ * @param graph The partitioned graph
+ * @param program The program
+ * @param options Ring size and superstep limit
+ * @return The value of every vertex by global ID, the supersteps run and the last global aggregate
+ * @throw std::runtime_error if a worker cannot be started or fails
+ */
+template<typename Program>
+BSPResult<typename Program::Value> run_bsp(const PartitionedGraph& graph, const Program& program,
+                                           const BSPOptions& options = {}) {
+    using Value = typename Program::Value;
+    static_assert(std::is_trivially_copyable_v<Value>, "Results are passed through shared memory");
+    if (options.ring_capacity == 0) {
+        throw std::invalid_argument("Ring capacity must be positive");
+    }
+    uint32_t parts = graph.parts();
+    bsp_detail::SharedState<Value> state(parts, options.ring_capacity, graph.vertex_count());
+    bsp_detail::SharedMemory stats_memory(sizeof(bsp_detail::RunStats));
+    auto* stats = new (stats_memory.as<bsp_detail::RunStats>()) bsp_detail::RunStats();
+
+    auto worker = [&](uint32_t part) {
+        const PartitionShard& shard = graph.shard(part);
+        Program local = program;
+        local.init(shard);
+        std::vector<BSPMessage> inbox;
+        std::vector<BSPMessage> received;
+        BSPAggregate global{};
+        for (size_t step = 0; step < options.max_supersteps; ++step) {
+            BSPOutbox<Value> outbox(state, part, received);
+            state.aggregates()[part] = local.superstep(step, shard, global, inbox, outbox);
+            // A worker still sending may be blocked on a full ring to this one, so keep draining
+            bsp_detail::barrier(state.control(), parts, [&] { outbox.drain_incoming(); });
+            outbox.drain_incoming();
+            global = {};
+            for (uint32_t p = 0; p < parts; ++p) {
+                for (size_t k = 0; k < global.size(); ++k) {
+                    global[k] += state.aggregates()[p][k];
+                }
+            }
+            bsp_detail::barrier(state.control(), parts, [] {});
+            inbox.swap(received);
+            received.clear();
+            if (part == 0) {
+                stats->supersteps.store(step + 1, std::memory_order_relaxed);
+                stats->last = global;
+            }
+            if (local.done(step, global)) {
+                break;
+            }
+        }
+        local.finish(shard, state.results());
+    };
+
+    std::vector<pid_t> children;
+    for (uint32_t part = 0; part < parts; ++part) {
+        pid_t pid = ::fork();
+        if (pid < 0) {
+            state.control().aborted.store(1);
+            bsp_detail::reap_workers(state.control(), children);
+            throw std::runtime_error("Cannot fork a BSP worker");
+        }
+        if (pid == 0) {
+            int status = 0;
+            try {
+                worker(part);
+            } catch (...) {
+                state.control().aborted.store(1);
+                status = 1;
+            }
+            ::_exit(status);
+        }
+        children.push_back(pid);
+    }
+
+    if (!bsp_detail::reap_workers(state.control(), children)) {
+        throw std::runtime_error("A BSP worker failed");
+    }
+    Value* results = state.results();
+    return {std::vector<Value>(results, results + graph.vertex_count()),
+            static_cast<size_t>(stats->supersteps.load(std::memory_order_relaxed)), stats->last};
+}
+
+namespace bsp_detail {
+
+// Level-synchronous BFS: the frontier of superstep s is at distance s
+class BFSProgram {
+private:
+    uint32_t source;
+    uint32_t source_part;
+    uint32_t source_local;
+    std::vector<uint32_t> distance;
+    std::vector<uint32_t> frontier;
+    std::vector<uint32_t> next;
+    std::vector<uint32_t> ghost_step;   // Superstep + 1 in which a ghost was last sent to
+
+public:
+    using Value = uint32_t;
+    static constexpr uint32_t UNREACHED = std::numeric_limits<uint32_t>::max();
+
+    BFSProgram(const PartitionedGraph& graph, uint32_t source)
+        : source(source), source_part(graph.partition().owner[source]),
+          source_local(graph.partition().local_id[source]) {}
+
+    void init(const PartitionShard& shard) {
+        distance.assign(shard.vertex_count(), UNREACHED);
+        ghost_step.assign(shard.ghost_count(), 0);
+        if (shard.part == source_part) {
+            distance[source_local] = 0;
+            next.push_back(source_local);
+        }
+    }
+
+    BSPAggregate superstep(size_t step, const PartitionShard& shard, const BSPAggregate&,
+                           const std::vector<BSPMessage>& inbox, BSPOutbox<Value>& outbox) {
+        uint32_t level = static_cast<uint32_t>(step);
+        frontier.swap(next);
+        next.clear();
+        for (const BSPMessage& message : inbox) {
+            if (distance[message.vertex] == UNREACHED) {
+                distance[message.vertex] = level;
+                frontier.push_back(message.vertex);
+            }
+        }
+        uint32_t local_count = static_cast<uint32_t>(shard.vertex_count());
+        for (uint32_t v : frontier) {
+            for (uint64_t arc = shard.offsets[v]; arc < shard.offsets[v + 1]; ++arc) {
+                uint32_t slot = shard.slots[arc];
+                if (slot < local_count) {
+                    if (distance[slot] == UNREACHED) {
+                        distance[slot] = level + 1;
+                        next.push_back(slot);
+                    }
+                } else if (ghost_step[slot - local_count] != level + 1) {
+                    ghost_step[slot - local_count] = level + 1;
+                    outbox.send(shard.ghost_owner[slot - local_count], shard.ghost_local[slot - local_count], 0.0);
+                }
+            }
+        }
+        return {static_cast<double>(next.size() + outbox.sent_count()), 0.0};
+    }
+
+    bool done(size_t, const BSPAggregate& global) const {
+        return global[0] == 0.0;
+    }
+
+    void finish(const PartitionShard& shard, Value* results) const {
+        for (uint32_t v = 0; v < shard.vertex_count(); ++v) {
+            results[shard.vertices[v]] = distance[v];
+        }
+    }
+};
+
+// PageRank as in pagerank(): superstep s applies the contributions pushed in s - 1.
+// aggregate[0] is the rank mass on dangling vertices, aggregate[1] the L1 change.
+class PageRankProgram {
+private:
+    double damping;
+    size_t max_iterations;
+    double tolerance;
+    double n;
+    std::vector<double> rank;
+    std::vector<double> gathered;
+    std::vector<double> ghost_sum;
+
+public:
+    using Value = double;
+
+    PageRankProgram(const PartitionedGraph& graph, double damping, const IterationOptions& options)
+        : damping(damping), max_iterations(options.max_iterations), tolerance(options.tolerance),
+          n(static_cast<double>(graph.vertex_count())) {}
+
+    void init(const PartitionShard& shard) {
+        rank.assign(shard.vertex_count(), 1.0 / n);
+        gathered.assign(shard.vertex_count(), 0.0);
+        ghost_sum.assign(shard.ghost_count(), 0.0);
+    }
+
+    BSPAggregate superstep(size_t step, const PartitionShard& shard, const BSPAggregate& global,
+                           const std::vector<BSPMessage>& inbox, BSPOutbox<Value>& outbox) {
+        double change = 0.0;
+        if (step > 0) {
+            for (const BSPMessage& message : inbox) {
+                gathered[message.vertex] += message.value;
+            }
+            for (size_t v = 0; v < rank.size(); ++v) {
+                double updated = (1.0 - damping) / n + damping * (gathered[v] + global[0] / n);
+                change += std::fabs(updated - rank[v]);
+                rank[v] = updated;
+                gathered[v] = 0.0;
+            }
+        }
+
+        double dangling = 0.0;
+        uint32_t local_count = static_cast<uint32_t>(shard.vertex_count());
+        for (uint32_t v = 0; v < local_count; ++v) {
+            uint64_t degree = shard.degree(v);
+            if (degree == 0) {
+                dangling += rank[v];
+                continue;
+            }
+            double share = rank[v] / static_cast<double>(degree);
+            for (uint64_t arc = shard.offsets[v]; arc < shard.offsets[v + 1]; ++arc) {
+                uint32_t slot = shard.slots[arc];
+                (slot < local_count ? gathered[slot] : ghost_sum[slot - local_count]) += share;
+            }
+        }
+        // One combined message per ghost
+        for (size_t g = 0; g < ghost_sum.size(); ++g) {
+            if (ghost_sum[g] != 0.0) {
+                outbox.send(shard.ghost_owner[g], shard.ghost_local[g], ghost_sum[g]);
+                ghost_sum[g] = 0.0;
+            }
+        }
+        return {dangling, change};
+    }
+
+    bool done(size_t step, const BSPAggregate& global) const {
+        return step >= max_iterations || (step > 0 && global[1] < tolerance);
+    }
+
+    void finish(const PartitionShard& shard, Value* results) const {
+        for (uint32_t v = 0; v < shard.vertex_count(); ++v) {
+            results[shard.vertices[v]] = rank[v];
+        }
+    }
+};
+
+} // namespace bsp_detail
+
+/**
+ * @brief Breadth-first search over a partitioned graph, one process per part
+ * @param graph The partitioned graph
+ * @param source The source vertex (global ID)
+ * @param options Ring size and superstep limit
+ * @return The hop distance of every vertex, UINT32_MAX if unreachable
+ * @throw std::out_of_range if the source is out of range
+ * @throw std::runtime_error if a worker fails
+ */
+inline std::vector<uint32_t> bsp_bfs(const PartitionedGraph& graph, uint32_t source, const BSPOptions& options = {}) {
+    if (source >= graph.vertex_count()) {
+        throw std::out_of_range("Source vertex ID is out of range");
+    }
+    return run_bsp(graph, bsp_detail::BFSProgram(graph, source), options).values;
+}
+
+/**
+ * @brief PageRank over a partitioned graph, one process per part (same equations as pagerank())
+ * @param graph The partitioned graph
+ * @param damping Probability of following an arc rather than teleporting
+ * @param iteration Iteration limit and L1 tolerance (threads does not apply)
+ * @param options Ring size and superstep limit
+ * @return The scores, the number of iterations, the last L1 change and whether it converged
+ * @throw std::runtime_error if a worker fails
+ */
+inline IterationResult bsp_pagerank(const PartitionedGraph& graph, double damping = 0.85,
+                                    const IterationOptions& iteration = {}, const BSPOptions& options = {}) {
+    auto run = run_bsp(graph, bsp_detail::PageRankProgram(graph, damping, iteration), options);
+    IterationResult result;
+    result.values = std::move(run.values);
+    result.iterations = run.supersteps == 0 ? 0 : run.supersteps - 1;
+    result.residual = run.last[1];
+    result.converged = result.iterations > 0 && result.residual < iteration.tolerance;
+    result.edges_processed = run.supersteps * graph.arc_count();
+    return result;
+}
+
+#endif // PARTITIONED_GRAPH_HPP
@@ -0,0 +1,377 @@
+/**
+ * @file reordering.hpp
+ * @brief Locality-improving vertex reorderings for CSR graphs
+ *
+ * Vertex IDs assigned from arbitrary source keys scatter the neighbors of a vertex all
+ * over memory. A reordering computes a permutation new_id[old_id] and relabel() rebuilds
+ * the CSR graph under it, so that vertices used together get nearby IDs:
+ * - degree_order(): descending degree, packing hubs into the first cache lines
+ * - hub_cluster_order(): hubs (above average degree) first, the rest in original order,
+ *   which keeps most of the existing locality
+ * - rcm_order(): reverse Cuthill-McKee, BFS levels with low-degree vertices first,
+ *   minimizing bandwidth on mesh- and road-like graphs
+ * - gorder(): greedy Gorder (Wei et al. 2016), placing next the vertex sharing the most
+ *   neighbor and sibling relations with the last `window` placed vertices
+ *
+ * evaluate_reordering() measures the effect on BFS and PageRank and on the average
+ * log-gap between consecutive neighbor IDs.
+ *
+ * Time Complexity:
+ * - Degree and hub orders: O(V log V)
+ * - RCM: O(V log V + E)
+ * - Gorder: O(sum over vertices of in-degree * out-degree * log V), hubs capped
+ * - relabel(): O(V + E log d)
+ *
+ * Space Complexity: O(V + E)
+ */
+
+#ifndef REORDERING_HPP
+#define REORDERING_HPP
+
+#include <vector>
+#include <queue>
+#include <cmath>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+#include "csr_graph.hpp"
+#include "traversal.hpp"
+#include "pagerank.hpp"
+#include "../other/parallel_for.hpp"
+
+namespace reordering_detail {
+
+// Turn a list of old IDs in their new order into new_id[old_id]
+inline std::vector<uint32_t> invert(const std::vector<uint32_t>& sequence) {
+    std::vector<uint32_t> new_id(sequence.size());
+    for (uint32_t position = 0; position < sequence.size(); ++position) {
+        new_id[sequence[position]] = position;
+    }
+    return new_id;
+}
+
+} // namespace reordering_detail
+
+/**
+ * @brief Order vertices by descending degree (ties keep the original order)
+ * @param graph The graph
+ * @return The permutation new_id[old_id]
+ */
+inline std::vector<uint32_t> degree_order(const CSRGraph& graph) {
+    std::vector<uint32_t> sequence(graph.vertex_count());
+    std::iota(sequence.begin(), sequence.end(), 0);
+    std::stable_sort(sequence.begin(), sequence.end(), [&](uint32_t a, uint32_t b) {
+        return graph.degree(a) > graph.degree(b);
+    });
+    return reordering_detail::invert(sequence);
+}
+
+/**
+ * @brief Move hubs (vertices above average degree) to the front, keeping both groups in original order
+ * @param graph The graph
+ * @return The permutation new_id[old_id]
+ */
+inline std::vector<uint32_t> hub_cluster_order(const CSRGraph& graph) {
+    size_t n = graph.vertex_count();
+    double average = n == 0 ? 0.0 : static_cast<double>(graph.arc_count()) / static_cast<double>(n);
+    std::vector<uint32_t> sequence;
+    sequence.reserve(n);
+    for (uint32_t v = 0; v < n; ++v) {
+        if (graph.degree(v) > average) {
+            sequence.push_back(v);
+        }
+    }
+    for (uint32_t v = 0; v < n; ++v) {
+        if (graph.degree(v) <= average) {
+            sequence.push_back(v);
+        }
+    }
+    return reordering_detail::invert(sequence);
+}
+
+/**
+ * @brief Reverse Cuthill-McKee ordering
+ * @param graph The graph (out-neighbors are used; pass a symmetric graph for the classic result)
+ * @return The permutation new_id[old_id]
+ */
+inline std::vector<uint32_t> rcm_order(const CSRGraph& graph) {
+    size_t n = graph.vertex_count();
+    std::vector<uint32_t> by_degree(n);
+    std::iota(by_degree.begin(), by_degree.end(), 0);
+    std::stable_sort(by_degree.begin(), by_degree.end(), [&](uint32_t a, uint32_t b) {
+        return graph.degree(a) < graph.degree(b);
+    });
+
+    std::vector<uint32_t> sequence;
+    sequence.reserve(n);
+    std::vector<bool> placed(n, false);
+    std::vector<uint32_t> children;
+
+    // Each component starts from its unplaced vertex of minimum degree (a cheap
+    // stand-in for a pseudo-peripheral vertex)
+    for (uint32_t start : by_degree) {
+        if (placed[start]) {
+            continue;
+        }
+        size_t head = sequence.size();
+        sequence.push_back(start);
+        placed[start] = true;
+        while (head < sequence.size()) {
+            uint32_t u = sequence[head++];
+            children.clear();
+            for (uint32_t v : graph.neighbors(u)) {
+                if (!placed[v]) {
+                    placed[v] = true;
+                    children.push_back(v);
+                }
+            }
+            std::stable_sort(children.begin(), children.end(), [&](uint32_t a, uint32_t b) {
+                return graph.degree(a) < graph.degree(b);
+            });
+            sequence.insert(sequence.end(), children.begin(), children.end());
+        }
+    }
+    std::reverse(sequence.begin(), sequence.end());
+    return reordering_detail::invert(sequence);
+}
+
+/**
+ * @brief Greedy Gorder ordering
+ * @param graph The graph
+ * @param window Number of most recently placed vertices whose relations are scored
+ * @return The permutation new_id[old_id]
+ */
+inline std::vector<uint32_t> gorder(const CSRGraph& graph, size_t window = 5) {
+    size_t n = graph.vertex_count();
+    if (n == 0) {
+        return {};
+    }
+    CSRGraph in_graph = graph.transpose();
+    // Sibling updates through a hub cost degree^2; like the reference implementation,
+    // skip hubs whose out-degree exceeds sqrt(V)
+    size_t hub_degree = static_cast<size_t>(std::sqrt(static_cast<double>(n))) + 1;
+
+    std::vector<int64_t> score(n, 0);
+    std::vector<bool> placed(n, false);
+    std::priority_queue<std::pair<int64_t, uint32_t>> heap;   // Lazy entries: stale ones are skipped
+
+    auto adjust = [&](uint32_t v, int64_t delta) {
+        if (!placed[v]) {
+            score[v] += delta;
+            if (delta > 0) {
+                heap.emplace(score[v], v);
+            }
+        }
+    };
+    // Apply delta to every vertex related to v: out-neighbors, in-neighbors and siblings
+    auto relate = [&](uint32_t v, int64_t delta) {
+        for (uint32_t u : graph.neighbors(v)) {
+            adjust(u, delta);
+        }
+        for (uint32_t u : in_graph.neighbors(v)) {
+            adjust(u, delta);
+            if (graph.degree(u) <= hub_degree) {
+                for (uint32_t sibling : graph.neighbors(u)) {
+                    if (sibling != v) {
+                        adjust(sibling, delta);
+                    }
+                }
+            }
+        }
+    };
+
+    std::vector<uint32_t> sequence;
+    sequence.reserve(n);
+    uint32_t start = 0;
+    for (uint32_t v = 1; v < n; ++v) {
+        if (in_graph.degree(v) > in_graph.degree(start)) {
+            start = v;
+        }
+    }
+    uint32_t scan = 0;   // Fallback cursor for when the heap holds no related vertex
+
+    uint32_t next = start;
+    while (true) {
+        placed[next] = true;
+        sequence.push_back(next);
+        relate(next, +1);
+        if (sequence.size() > window) {
+            relate(sequence[sequence.size() - window - 1], -1);
+        }
+        if (sequence.size() == n) {
+            break;
+        }
+
+        next = UINT32_MAX;
+        while (!heap.empty()) {
+            auto [s, v] = heap.top();
+            heap.pop();
+            if (!placed[v] && s == score[v] && s > 0) {
+                next = v;
+                break;
+            }
+        }
+        if (next == UINT32_MAX) {
+            while (placed[scan]) {
+                scan++;
+            }
+            next = scan;
+        }
+    }
+    return reordering_detail::invert(sequence);
+}
+
+/**
+ * @brief Rebuild a CSR graph with relabeled vertices
+ * @param graph The graph
+ * @param new_id The permutation new_id[old_id]
+ * @param threads Worker threads (0 means default_thread_count())
+ * @return The relabeled graph, with neighbor lists sorted by new ID
+ * @throw std::invalid_argument if new_id has the wrong size
+ */
+inline CSRGraph relabel(const CSRGraph& graph, const std::vector<uint32_t>& new_id, size_t threads = 0) {
+    size_t n = graph.vertex_count();
+    if (new_id.size() != n) {
+        throw std::invalid_argument("Permutation size does not match the vertex count");
+    }
+    std::vector<uint32_t> old_id(n);
+    for (uint32_t v = 0; v < n; ++v) {
+        old_id[new_id[v]] = v;
+    }
+
+    std::vector<uint64_t> offsets(n + 1, 0);
+    for (uint32_t v = 0; v < n; ++v) {
+        offsets[v + 1] = offsets[v] + graph.degree(old_id[v]);
+    }
+    std::vector<uint32_t> targets(graph.arc_count());
+    std::vector<int> weights(graph.is_weighted() ? graph.arc_count() : 0);
+
+    std::vector<std::vector<std::pair<uint32_t, int>>> scratch(threads == 0 ? default_thread_count() : threads);
+    parallel_for_blocks(0, n, 1024, [&](size_t lo, size_t hi, size_t worker) {
+        auto& arcs = scratch[worker];
+        for (size_t v = lo; v < hi; ++v) {
+            uint32_t old = old_id[v];
+            auto neighbors = graph.neighbors(old);
+            auto arc_weights = graph.neighbor_weights(old);
+            arcs.clear();
+            for (size_t i = 0; i < neighbors.size(); ++i) {
+                arcs.emplace_back(new_id[neighbors[i]], arc_weights.empty() ? 1 : arc_weights[i]);
+            }
+            std::sort(arcs.begin(), arcs.end());
+            for (size_t i = 0; i < arcs.size(); ++i) {
+                targets[offsets[v] + i] = arcs[i].first;
+                if (!weights.empty()) {
+                    weights[offsets[v] + i] = arcs[i].second;
+                }
+            }
+        }
+    }, scratch.size());
+    return CSRGraph(std::move(offsets), std::move(targets), std::move(weights), graph.is_directed());
+}
+
+/**
+ * @brief Rebuild a snapshot with relabeled vertices, keeping the key mapping consistent
+ * @param snapshot The snapshot
+ * @param new_id The permutation new_id[old_id]
+ * @return The relabeled snapshot
+ */
+template<typename T>
+GraphSnapshot<T> relabel(const GraphSnapshot<T>& snapshot, const std::vector<uint32_t>& new_id) {
+    std::vector<T> keys(snapshot.vertex_count());
+    for (uint32_t v = 0; v < keys.size(); ++v) {
+        keys[new_id[v]] = snapshot.key_of(v);
+    }
+    return GraphSnapshot<T>(relabel(snapshot.csr(), new_id), std::move(keys));
+}
+
+/**
+ * @brief Average log2 gap between consecutive neighbor IDs, a proxy for access locality
+ * @param graph The graph
+ * @return Mean of log2(|gap| + 1) over all arcs (the first gap of a list is taken from the vertex itself)
+ */
+inline double average_log_gap(const CSRGraph& graph) {
+    double total = 0.0;
+    for (uint32_t v = 0; v < graph.vertex_count(); ++v) {
+        int64_t previous = v;
+        for (uint32_t u : graph.neighbors(v)) {
+            total += std::log2(static_cast<double>(std::llabs(static_cast<int64_t>(u) - previous)) + 1.0);
+            previous = u;
+        }
+    }
+    return graph.arc_count() == 0 ? 0.0 : total / static_cast<double>(graph.arc_count());
+}
+
+/**
+ * @brief Measured effect of a reordering
+ */
+struct ReorderingReport {
+    double bfs_seconds_before = 0.0;
+    double bfs_seconds_after = 0.0;
+    double pagerank_seconds_before = 0.0;
+    double pagerank_seconds_after = 0.0;
+    double log_gap_before = 0.0;
+    double log_gap_after = 0.0;
+
+    double bfs_speedup() const {
+        return bfs_seconds_after > 0 ? bfs_seconds_before / bfs_seconds_after : 0.0;
+    }
+
+    double pagerank_speedup() const {
+        return pagerank_seconds_after > 0 ? pagerank_seconds_before / pagerank_seconds_after : 0.0;
+    }
+};
+
+/**
+ * @brief Time BFS and PageRank on a graph before and after relabeling
+ * @param before The original graph
+ * @param new_id The permutation new_id[old_id]
+ * @param repetitions Runs per measurement; the fastest run is reported
+ * @param pagerank_iterations PageRank iterations per run
+ * @return Timings and log-gap locality of both layouts
+ */
+inline ReorderingReport evaluate_reordering(const CSRGraph& before, const std::vector<uint32_t>& new_id,
+                                            size_t repetitions = 3, size_t pagerank_iterations = 10) {
+    CSRGraph after = relabel(before, new_id);
+    ReorderingReport report;
+    report.log_gap_before = average_log_gap(before);
+    report.log_gap_after = average_log_gap(after);
+    if (before.vertex_count() == 0) {
+        return report;
+    }
+
+    uint32_t source = 0;
+    for (uint32_t v = 1; v < before.vertex_count(); ++v) {
+        if (before.degree(v) > before.degree(source)) {
+            source = v;
+        }
+    }
+
+    auto fastest = [&](auto&& run) {
+        double best = 1e300;
+        for (size_t i = 0; i < repetitions; ++i) {
+            auto started = std::chrono::steady_clock::now();
+            run();
+            best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count());
+        }
+        return best;
+    };
+
+    TraversalScratch scratch;
+    TraversalVisitor visitor;
+    report.bfs_seconds_before = fastest([&] { breadth_first_visit(before, source, visitor, scratch); });
+    report.bfs_seconds_after = fastest([&] { breadth_first_visit(after, new_id[source], visitor, scratch); });
+
+    IterationOptions options;
+    options.max_iterations = pagerank_iterations;
+    options.tolerance = 0.0;
+    CSRGraph before_in = before.transpose();
+    CSRGraph after_in = after.transpose();
+    report.pagerank_seconds_before = fastest([&] { pagerank(before, before_in, 0.85, options); });
+    report.pagerank_seconds_after = fastest([&] { pagerank(after, after_in, 0.85, options); });
+    return report;
+}
+
+#endif // REORDERING_HPP
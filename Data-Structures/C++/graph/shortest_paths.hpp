@@ -0,0 +1,507 @@
+/**
+ * @file shortest_paths.hpp
+ * @brief Single-source shortest paths on a CSRGraph
+ *
+ * - dijkstra(): Dijkstra's algorithm with either a 4-ary indexed heap (decrease-key,
+ *   at most V entries) or a radix heap (monotone integer keys, O(1) amortized push).
+ * - astar(): A* search towards one target with a pluggable heuristic.
+ * - delta_stepping(): parallel label-correcting search that settles all vertices in
+ *   a distance bucket [i * delta, (i + 1) * delta) at once.
+ *
+ * Every search can stop early once a target is settled. Edge weights must be
+ * non-negative; distances are 64-bit.
+ *
+ * Time Complexity:
+ * - Dijkstra (4-ary heap): O((V + E) log V)
+ * - Dijkstra (radix heap): O(E + V log C) for maximum edge weight C
+ * - A*: O((V + E) log V) in the worst case, usually far less with a good heuristic
+ * - Delta-stepping: O(V + E + (L / delta) * threads) work per light phase for path weight L
+ *
+ * Space Complexity: O(V)
+ */
+
+#ifndef SHORTEST_PATHS_HPP
+#define SHORTEST_PATHS_HPP
+
+#include <vector>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "csr_graph.hpp"
+#include "../other/parallel_for.hpp"
+
+/**
+ * @brief Distances and shortest-path tree produced by the searches in this file
+ */
+struct ShortestPathResult {
+    static constexpr int64_t UNREACHABLE = std::numeric_limits<int64_t>::max();
+    static constexpr uint32_t NO_VERTEX = std::numeric_limits<uint32_t>::max();
+
+    std::vector<int64_t> distance;   // UNREACHABLE for vertices that were not reached (or not settled before stopping)
+    std::vector<uint32_t> parent;    // Predecessor on a shortest path, NO_VERTEX for the source and unreached vertices
+    uint32_t source = NO_VERTEX;
+
+    /**
+     * @brief Check if a vertex was reached
+     * @param vertex The vertex ID
+     * @return true if a distance is known, false otherwise
+     */
+    bool reachable(uint32_t vertex) const {
+        return distance[vertex] != UNREACHABLE;
+    }
+
+    /**
+     * @brief Reconstruct the shortest path from the source to a vertex
+     * @param target The vertex ID
+     * @return The vertex IDs from the source to the target, or an empty vector if unreachable
+     */
+    std::vector<uint32_t> path_to(uint32_t target) const {
+        if (!reachable(target)) {
+            return {};
+        }
+        std::vector<uint32_t> path;
+        for (uint32_t v = target; v != NO_VERTEX; v = parent[v]) {
+            path.push_back(v);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+};
+
+/**
+ * @class IndexedDaryHeap
+ * @brief Min-heap of (key, vertex) with one entry per vertex and decrease-key
+ *
+ * A 4-ary layout halves the tree height of a binary heap and keeps the children of a
+ * node in one cache line, which is the usual sweet spot for Dijkstra.
+ */
+template<unsigned D = 4>
+class IndexedDaryHeap {
+private:
+    static constexpr uint32_t NOT_IN_HEAP = std::numeric_limits<uint32_t>::max();
+
+    std::vector<std::pair<int64_t, uint32_t>> heap;
+    std::vector<uint32_t> position;
+
+    void place(size_t index, const std::pair<int64_t, uint32_t>& entry) {
+        heap[index] = entry;
+        position[entry.second] = static_cast<uint32_t>(index);
+    }
+
+    void sift_up(size_t index) {
+        auto entry = heap[index];
+        while (index > 0) {
+            size_t parent = (index - 1) / D;
+            if (heap[parent].first <= entry.first) {
+                break;
+            }
+            place(index, heap[parent]);
+            index = parent;
+        }
+        place(index, entry);
+    }
+
+    void sift_down(size_t index) {
+        auto entry = heap[index];
+        while (true) {
+            size_t first = index * D + 1;
+            if (first >= heap.size()) {
+                break;
+            }
+            size_t last = std::min(first + D, heap.size());
+            size_t best = first;
+            for (size_t child = first + 1; child < last; ++child) {
+                if (heap[child].first < heap[best].first) {
+                    best = child;
+                }
+            }
+            if (heap[best].first >= entry.first) {
+                break;
+            }
+            place(index, heap[best]);
+            index = best;
+        }
+        place(index, entry);
+    }
+
+public:
+    /**
+     * @brief Constructor
+     * @param vertex_count Number of distinct vertices that may be pushed
+     */
+    explicit IndexedDaryHeap(size_t vertex_count) : position(vertex_count, NOT_IN_HEAP) {}
+
+    bool empty() const {
+        return heap.empty();
+    }
+
+    /**
+     * @brief Insert a vertex, or lower its key if it is already queued with a larger one
+     * @param vertex The vertex ID
+     * @param key The new key
+     */
+    void push(uint32_t vertex, int64_t key) {
+        if (position[vertex] == NOT_IN_HEAP) {
+            heap.emplace_back(key, vertex);
+            sift_up(heap.size() - 1);
+        } else if (key < heap[position[vertex]].first) {
+            heap[position[vertex]].first = key;
+            sift_up(position[vertex]);
+        }
+    }
+
+    /**
+     * @brief Remove the entry with the smallest key
+     * @return The (key, vertex) pair
+     */
+    std::pair<int64_t, uint32_t> pop() {
+        auto top = heap.front();
+        position[top.second] = NOT_IN_HEAP;
+        if (heap.size() > 1) {
+            heap.front() = heap.back();
+            heap.pop_back();
+            sift_down(0);
+        } else {
+            heap.pop_back();
+        }
+        return top;
+    }
+};
+
+/**
+ * @class RadixHeap
+ * @brief Monotone min-heap for non-negative integer keys
+ *
+ * Entries live in 65 buckets by the highest bit in which their key differs from the
+ * last extracted minimum. Keys pushed must not be smaller than that minimum, which
+ * always holds for Dijkstra. Duplicate vertices are allowed; stale entries are
+ * skipped by the caller.
+ */
+class RadixHeap {
+private:
+    std::array<std::vector<std::pair<int64_t, uint32_t>>, 65> buckets;
+    uint64_t last = 0;
+    size_t count = 0;
+
+    size_t bucket_of(int64_t key) const {
+        return static_cast<size_t>(std::bit_width(static_cast<uint64_t>(key) ^ last));
+    }
+
+public:
+    explicit RadixHeap(size_t = 0) {}
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    void push(uint32_t vertex, int64_t key) {
+        buckets[bucket_of(key)].emplace_back(key, vertex);
+        count++;
+    }
+
+    std::pair<int64_t, uint32_t> pop() {
+        if (buckets[0].empty()) {
+            size_t i = 1;
+            while (buckets[i].empty()) {
+                i++;
+            }
+            last = static_cast<uint64_t>(std::min_element(buckets[i].begin(), buckets[i].end())->first);
+            for (const auto& entry : buckets[i]) {
+                buckets[bucket_of(entry.first)].push_back(entry);
+            }
+            buckets[i].clear();
+        }
+        auto top = buckets[0].back();
+        buckets[0].pop_back();
+        count--;
+        return top;
+    }
+};
+
+/**
+ * @brief Priority queue used by dijkstra()
+ */
+enum class DijkstraHeap {
+    DAry,   // 4-ary indexed heap with decrease-key
+    Radix   // Radix heap, best for small integer weights
+};
+
+namespace shortest_paths_detail {
+
+template<typename Heap, typename Potential>
+ShortestPathResult search(const CSRGraph& graph, uint32_t source, uint32_t target, Potential potential) {
+    size_t n = graph.vertex_count();
+    if (source >= n || (target != ShortestPathResult::NO_VERTEX && target >= n)) {
+        throw std::out_of_range("Vertex ID is out of range");
+    }
+
+    ShortestPathResult result;
+    result.source = source;
+    result.distance.assign(n, ShortestPathResult::UNREACHABLE);
+    result.parent.assign(n, ShortestPathResult::NO_VERTEX);
+    std::vector<bool> settled(n, false);
+
+    const auto& offsets = graph.offsets();
+    const auto& targets = graph.targets();
+
+    Heap heap(n);
+    result.distance[source] = 0;
+    heap.push(source, potential(source));
+
+    while (!heap.empty()) {
+        auto [key, u] = heap.pop();
+        if (settled[u]) {
+            continue;
+        }
+        settled[u] = true;
+        if (u == target) {
+            break;
+        }
+
+        int64_t du = result.distance[u];
+        for (uint64_t arc = offsets[u]; arc < offsets[u + 1]; ++arc) {
+            int weight = graph.weight(arc);
+            if (weight < 0) {
+                throw std::invalid_argument("Shortest paths require non-negative edge weights");
+            }
+            uint32_t v = targets[arc];
+            int64_t candidate = du + weight;
+            if (candidate < result.distance[v]) {
+                result.distance[v] = candidate;
+                result.parent[v] = u;
+                heap.push(v, candidate + potential(v));
+            }
+        }
+    }
+
+    // Tentative distances of vertices that were never settled are not final
+    if (target != ShortestPathResult::NO_VERTEX) {
+        for (size_t v = 0; v < n; ++v) {
+            if (!settled[v]) {
+                result.distance[v] = ShortestPathResult::UNREACHABLE;
+                result.parent[v] = ShortestPathResult::NO_VERTEX;
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace shortest_paths_detail
+
+/**
+ * @brief Compute shortest paths from a source with Dijkstra's algorithm
+ * @param graph The graph (weights must be non-negative)
+ * @param source The source vertex ID
+ * @param target Stop once this vertex is settled (NO_VERTEX searches the whole graph)
+ * @param heap The priority queue to use
+ * @return Distances and parents; with a target, only settled vertices are reported
+ * @throw std::invalid_argument if a negative weight is encountered
+ * @throw std::out_of_range if a vertex ID is out of range
+ */
+inline ShortestPathResult dijkstra(const CSRGraph& graph, uint32_t source,
+                                   uint32_t target = ShortestPathResult::NO_VERTEX,
+                                   DijkstraHeap heap = DijkstraHeap::DAry) {
+    auto zero = [](uint32_t) { return int64_t(0); };
+    if (heap == DijkstraHeap::Radix) {
+        return shortest_paths_detail::search<RadixHeap>(graph, source, target, zero);
+    }
+    return shortest_paths_detail::search<IndexedDaryHeap<4>>(graph, source, target, zero);
+}
+
+/**
+ * @brief Compute a shortest path from source to target with A* search
+ * @param graph The graph (weights must be non-negative)
+ * @param source The source vertex ID
+ * @param target The target vertex ID
+ * @param heuristic Callable heuristic(v) returning a lower bound on the distance from v to
+ *                  the target; it must be consistent (h(u) <= w(u, v) + h(v), h(target) == 0)
+ * @return Distances and parents of the settled vertices; use path_to(target)
+ */
+template<typename Heuristic>
+ShortestPathResult astar(const CSRGraph& graph, uint32_t source, uint32_t target, Heuristic&& heuristic) {
+    return shortest_paths_detail::search<IndexedDaryHeap<4>>(graph, source, target, [&](uint32_t v) {
+        return static_cast<int64_t>(heuristic(v));
+    });
+}
+
+/**
+ * @brief Tuning knobs for delta_stepping()
+ */
+struct DeltaSteppingOptions {
+    int64_t delta = 0;                                  // Bucket width (0 derives it from the graph)
+    size_t threads = 0;                                 // Worker threads (0 means default_thread_count())
+    uint32_t target = ShortestPathResult::NO_VERTEX;    // Stop once this vertex's bucket is done
+    bool parents = true;                                // Build the shortest-path tree afterwards
+};
+
+/**
+ * @brief Compute shortest paths from a source with parallel delta-stepping
+ * @param graph The graph (weights must be non-negative)
+ * @param source The source vertex ID
+ * @param options Bucket width, thread count, early target and parent reconstruction
+ * @return Distances and (optionally) parents
+ * @throw std::invalid_argument if the graph has a negative weight
+ * @throw std::out_of_range if a vertex ID is out of range
+ */
+inline ShortestPathResult delta_stepping(const CSRGraph& graph, uint32_t source, DeltaSteppingOptions options = {}) {
+    constexpr int64_t INF = ShortestPathResult::UNREACHABLE;
+    size_t n = graph.vertex_count();
+    uint32_t target = options.target;
+    if (source >= n || (target != ShortestPathResult::NO_VERTEX && target >= n)) {
+        throw std::out_of_range("Vertex ID is out of range");
+    }
+
+    const auto& offsets = graph.offsets();
+    const auto& targets = graph.targets();
+    size_t threads = options.threads == 0 ? default_thread_count() : options.threads;
+
+    int64_t max_weight = 1;
+    for (int weight : graph.weights()) {
+        if (weight < 0) {
+            throw std::invalid_argument("Shortest paths require non-negative edge weights");
+        }
+        max_weight = std::max<int64_t>(max_weight, weight);
+    }
+    int64_t delta = options.delta;
+    if (delta <= 0) {
+        // Meyer and Sanders: a width of about max_weight / average_degree balances the phases
+        size_t average_degree = std::max<size_t>(1, graph.arc_count() / std::max<size_t>(1, n));
+        delta = std::max<int64_t>(1, max_weight / static_cast<int64_t>(average_degree));
+    }
+
+    std::vector<std::atomic<int64_t>> distance(n);
+    for (auto& d : distance) {
+        d.store(INF, std::memory_order_relaxed);
+    }
+    distance[source].store(0, std::memory_order_relaxed);
+
+    // Every worker keeps its own buckets; a vertex may appear in several buckets and
+    // stale copies are skipped when their bucket is processed
+    std::vector<std::vector<std::vector<uint32_t>>> local_bins(threads);
+    std::vector<uint32_t> frontier{source};
+    size_t current_bin = 0;
+
+    while (!frontier.empty()) {
+        int64_t bin_start = static_cast<int64_t>(current_bin) * delta;
+        if (target != ShortestPathResult::NO_VERTEX && distance[target].load() < bin_start) {
+            break;
+        }
+
+        parallel_for_blocks(0, frontier.size(), 64, [&](size_t lo, size_t hi, size_t worker) {
+            auto& bins = local_bins[worker];
+            for (size_t i = lo; i < hi; ++i) {
+                uint32_t u = frontier[i];
+                int64_t du = distance[u].load(std::memory_order_relaxed);
+                if (du < bin_start) {
+                    continue;   // Already settled with a smaller distance in an earlier bucket
+                }
+                for (uint64_t arc = offsets[u]; arc < offsets[u + 1]; ++arc) {
+                    uint32_t v = targets[arc];
+                    int64_t candidate = du + graph.weight(arc);
+                    int64_t old = distance[v].load(std::memory_order_relaxed);
+                    while (candidate < old) {
+                        if (distance[v].compare_exchange_weak(old, candidate, std::memory_order_relaxed)) {
+                            size_t bin = static_cast<size_t>(candidate / delta);
+                            if (bin >= bins.size()) {
+                                bins.resize(bin + 1);
+                            }
+                            bins[bin].push_back(v);
+                            break;
+                        }
+                    }
+                }
+            }
+        }, threads);
+
+        size_t next_bin = std::numeric_limits<size_t>::max();
+        for (const auto& bins : local_bins) {
+            for (size_t bin = current_bin; bin < bins.size() && bin < next_bin; ++bin) {
+                if (!bins[bin].empty()) {
+                    next_bin = bin;
+                    break;
+                }
+            }
+        }
+
+        frontier.clear();
+        if (next_bin == std::numeric_limits<size_t>::max()) {
+            break;
+        }
+        for (auto& bins : local_bins) {
+            if (next_bin < bins.size()) {
+                frontier.insert(frontier.end(), bins[next_bin].begin(), bins[next_bin].end());
+                bins[next_bin].clear();
+            }
+        }
+        current_bin = next_bin;
+    }
+
+    ShortestPathResult result;
+    result.source = source;
+    result.distance.resize(n);
+    for (size_t v = 0; v < n; ++v) {
+        result.distance[v] = distance[v].load(std::memory_order_relaxed);
+    }
+    result.parent.assign(n, ShortestPathResult::NO_VERTEX);
+
+    if (target != ShortestPathResult::NO_VERTEX) {
+        // Only vertices up to the target's distance are final when the search stopped early
+        int64_t limit = result.distance[target];
+        for (auto& d : result.distance) {
+            if (d > limit) {
+                d = INF;
+            }
+        }
+    }
+
+    if (options.parents) {
+        // BFS over tight arcs (distance[u] + w == distance[v]) gives each vertex one
+        // predecessor even when zero-weight edges form cycles
+        std::vector<bool> reached(n, false);
+        std::queue<uint32_t> queue;
+        queue.push(source);
+        reached[source] = true;
+        while (!queue.empty()) {
+            uint32_t u = queue.front();
+            queue.pop();
+            for (uint64_t arc = offsets[u]; arc < offsets[u + 1]; ++arc) {
+                uint32_t v = targets[arc];
+                if (!reached[v] && result.distance[v] != INF && result.distance[u] + graph.weight(arc) == result.distance[v]) {
+                    reached[v] = true;
+                    result.parent[v] = u;
+                    queue.push(v);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Compute a shortest path between two vertices of a snapshot by key
+ * @param snapshot The frozen graph
+ * @param from The source key
+ * @param to The target key
+ * @return The path length and the keys along the path (empty if unreachable)
+ * @throw std::out_of_range if a key is not in the snapshot
+ */
+template<typename T>
+std::pair<int64_t, std::vector<T>> shortest_path(const GraphSnapshot<T>& snapshot, const T& from, const T& to) {
+    uint32_t target = snapshot.id_of(to);
+    ShortestPathResult result = dijkstra(snapshot.csr(), snapshot.id_of(from), target);
+
+    std::vector<T> path;
+    for (uint32_t v : result.path_to(target)) {
+        path.push_back(snapshot.key_of(v));
+    }
+    return {result.distance[target], path};
+}
+
+#endif // SHORTEST_PATHS_HPP
@@ -0,0 +1,212 @@
+/**
+ * @file strong_components.hpp
+ * @brief Strongly connected components, condensation DAG and cycle detection on a CSRGraph
+ *
+ * strongly_connected_components() is Pearce's space-efficient variant of Tarjan's
+ * algorithm (PEA_FIND_SCC2, 2016): a single rindex array doubles as DFS index, lowlink
+ * and final component number, plus one root bit per vertex. The DFS runs on an explicit
+ * stack of (vertex, next arc) pairs, so paths of any length (e.g. 10^7-vertex chains)
+ * are handled without recursion.
+ *
+ * Components are numbered in topological order of the condensation: every arc between
+ * two components goes from a lower label to a higher one.
+ *
+ * Time Complexity: O(V + E) for every function
+ *
+ * Space Complexity: O(V) for the SCC search, O(V + E) for the condensation
+ */
+
+#ifndef STRONG_COMPONENTS_HPP
+#define STRONG_COMPONENTS_HPP
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include "csr_graph.hpp"
+
+/**
+ * @brief Strongly connected components produced by strongly_connected_components()
+ */
+struct SCCResult {
+    std::vector<uint32_t> label;    // Component of every vertex, in topological order of the condensation
+    std::vector<size_t> sizes;      // sizes[c] is the number of vertices in component c
+
+    /**
+     * @brief Get the number of components
+     */
+    size_t count() const {
+        return sizes.size();
+    }
+
+    /**
+     * @brief Check if two vertices are strongly connected
+     */
+    bool same_component(uint32_t a, uint32_t b) const {
+        return label[a] == label[b];
+    }
+
+    /**
+     * @brief Check if every component is a single vertex (the graph is acyclic apart from self-loops)
+     */
+    bool all_trivial() const {
+        return sizes.size() == label.size();
+    }
+};
+
+/**
+ * @brief Find the strongly connected components of a directed graph
+ * @param graph The graph (an undirected graph yields its connected components)
+ * @return The component label of every vertex
+ */
+inline SCCResult strongly_connected_components(const CSRGraph& graph) {
+    size_t n = graph.vertex_count();
+    const auto& offsets = graph.offsets();
+    const auto& targets = graph.targets();
+
+    // rindex[v] is 0 while v is unvisited, then its DFS index lowered to the smallest
+    // index reachable, and finally its component number counted down from n - 1, which
+    // is larger than any live index so finished vertices never lower a lowlink
+    std::vector<uint32_t> rindex(n, 0);
+    std::vector<bool> root(n, false);
+    std::vector<uint32_t> open;                                 // Visited vertices not yet assigned
+    std::vector<std::pair<uint32_t, uint64_t>> call_stack;      // (vertex, next arc)
+    uint32_t index = 1;
+    uint32_t component = static_cast<uint32_t>(n) - 1;
+
+    auto begin_visit = [&](uint32_t v) {
+        root[v] = true;
+        rindex[v] = index++;
+        call_stack.emplace_back(v, offsets[v]);
+    };
+
+    for (uint32_t start = 0; start < n; ++start) {
+        if (rindex[start] != 0) {
+            continue;
+        }
+        begin_visit(start);
+        while (!call_stack.empty()) {
+            auto& [v, arc] = call_stack.back();
+            if (arc < offsets[v + 1]) {
+                uint32_t w = targets[arc++];
+                if (rindex[w] == 0) {
+                    begin_visit(w);   // May reallocate: v and arc are not used after this
+                } else if (rindex[w] < rindex[v]) {
+                    rindex[v] = rindex[w];
+                    root[v] = false;
+                }
+                continue;
+            }
+
+            uint32_t finished = v;
+            call_stack.pop_back();
+            if (root[finished]) {
+                index--;
+                while (!open.empty() && rindex[finished] <= rindex[open.back()]) {
+                    rindex[open.back()] = component;
+                    open.pop_back();
+                    index--;
+                }
+                rindex[finished] = component--;
+            } else {
+                open.push_back(finished);
+            }
+            // Propagate the lowlink to the parent, as the recursive version does on return
+            if (!call_stack.empty()) {
+                uint32_t parent = call_stack.back().first;
+                if (rindex[finished] < rindex[parent]) {
+                    rindex[parent] = rindex[finished];
+                    root[parent] = false;
+                }
+            }
+        }
+    }
+
+    // Components were numbered n - 1 downwards in completion order, i.e. reverse
+    // topological order; shift them to 0 .. count - 1
+    SCCResult result;
+    uint32_t first = component + 1;
+    result.sizes.assign(n - first, 0);
+    result.label.resize(n);
+    for (uint32_t v = 0; v < n; ++v) {
+        result.label[v] = rindex[v] - first;
+        result.sizes[result.label[v]]++;
+    }
+    return result;
+}
+
+/**
+ * @brief Build the condensation DAG, with one vertex per strongly connected component
+ * @param graph The graph
+ * @param components The result of strongly_connected_components(graph)
+ * @return A directed, unweighted graph with one arc per pair of adjacent components;
+ *         every arc goes from a lower to a higher component ID
+ */
+inline CSRGraph condensation(const CSRGraph& graph, const SCCResult& components) {
+    size_t k = components.count();
+    std::vector<std::pair<uint32_t, uint32_t>> arcs;
+    for (uint32_t v = 0; v < graph.vertex_count(); ++v) {
+        for (uint32_t w : graph.neighbors(v)) {
+            if (components.label[v] != components.label[w]) {
+                arcs.emplace_back(components.label[v], components.label[w]);
+            }
+        }
+    }
+    std::sort(arcs.begin(), arcs.end());
+    arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
+
+    std::vector<uint64_t> offsets(k + 1, 0);
+    std::vector<uint32_t> targets(arcs.size());
+    for (size_t i = 0; i < arcs.size(); ++i) {
+        offsets[arcs[i].first + 1]++;
+        targets[i] = arcs[i].second;
+    }
+    for (size_t c = 0; c < k; ++c) {
+        offsets[c + 1] += offsets[c];
+    }
+    return CSRGraph(std::move(offsets), std::move(targets), {}, true);
+}
+
+/**
+ * @brief Find a directed cycle
+ * @param graph The graph
+ * @return The vertices of one cycle in arc order (v0 -> v1 -> ... -> v0), or an empty
+ *         vector if the graph is acyclic; a self-loop is a cycle of one vertex
+ */
+inline std::vector<uint32_t> find_cycle(const CSRGraph& graph) {
+    for (uint32_t v = 0; v < graph.vertex_count(); ++v) {
+        if (graph.has_edge(v, v)) {
+            return {v};
+        }
+    }
+    SCCResult components = strongly_connected_components(graph);
+    if (components.all_trivial()) {
+        return {};
+    }
+
+    // Inside a non-trivial component every vertex has an arc to another member, so
+    // following such arcs must eventually revisit a vertex
+    uint32_t start = 0;
+    while (components.sizes[components.label[start]] < 2) {
+        start++;
+    }
+    uint32_t label = components.label[start];
+    std::vector<uint32_t> walk;
+    std::vector<uint32_t> position(graph.vertex_count(), UINT32_MAX);
+    uint32_t v = start;
+    while (position[v] == UINT32_MAX) {
+        position[v] = static_cast<uint32_t>(walk.size());
+        walk.push_back(v);
+        for (uint32_t w : graph.neighbors(v)) {
+            if (components.label[w] == label) {
+                v = w;
+                break;
+            }
+        }
+    }
+    return std::vector<uint32_t>(walk.begin() + position[v], walk.end());
+}
+
+#endif // STRONG_COMPONENTS_HPP
@@ -0,0 +1,221 @@
+/**
+ * @file topological_sort.hpp
+ * @brief Topological ordering of a directed CSRGraph (Kahn's algorithm, sequential and parallel)
+ *
+ * topological_sort() repeatedly removes a vertex without incoming arcs, using a FIFO
+ * queue. lexicographic_topological_sort() keeps those vertices in a min-heap instead,
+ * so every tie goes to the smallest ID and the result is the lexicographically
+ * smallest topological order. topological_levels() removes a whole frontier at a time: level 0 holds the
+ * vertices without incoming arcs and level k + 1 the vertices whose last remaining
+ * predecessor is in level k. Each frontier is processed in parallel with atomic
+ * in-degree counters; the levels are the longest-path depths, so vertices of the same
+ * level are independent and can be scheduled together.
+ *
+ * Both throw if the graph has a cycle; find_cycle() in strong_components.hpp reports one.
+ * Neither recurses, so arbitrarily deep DAGs are fine.
+ *
+ * Time Complexity: O(V + E) work (plus O(V log V) for the min-heap or to sort each
+ * parallel level)
+ *
+ * Space Complexity: O(V)
+ */
+
+#ifndef TOPOLOGICAL_SORT_HPP
+#define TOPOLOGICAL_SORT_HPP
+
+#include <queue>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+
+#include "csr_graph.hpp"
+#include "../other/parallel_for.hpp"
+
+/**
+ * @brief A topological order grouped into independent levels
+ */
+struct TopologicalLevels {
+    std::vector<uint32_t> order;            // Vertices level by level, ascending ID within a level
+    std::vector<size_t> level_offsets;      // Level k is order[level_offsets[k], level_offsets[k + 1])
+    std::vector<uint32_t> level;            // Level of every vertex
+
+    /**
+     * @brief Get the number of levels (the length of the longest path, in vertices)
+     */
+    size_t depth() const {
+        return level_offsets.empty() ? 0 : level_offsets.size() - 1;
+    }
+};
+
+namespace topological_detail {
+
+inline void require_directed(const CSRGraph& graph) {
+    if (!graph.is_directed()) {
+        throw std::invalid_argument("Topological ordering requires a directed graph");
+    }
+}
+
+} // namespace topological_detail
+
+/**
+ * @brief Order the vertices so that every arc goes from an earlier to a later vertex
+ * @param graph The graph (directed)
+ * @return The vertices in topological order
+ * @throw std::invalid_argument if the graph is undirected
+ * @throw std::runtime_error if the graph has a cycle
+ */
+inline std::vector<uint32_t> topological_sort(const CSRGraph& graph) {
+    topological_detail::require_directed(graph);
+    size_t n = graph.vertex_count();
+    std::vector<uint32_t> in_degree(n, 0);
+    for (uint32_t w : graph.targets()) {
+        in_degree[w]++;
+    }
+
+    std::vector<uint32_t> order;
+    order.reserve(n);
+    for (uint32_t v = 0; v < n; ++v) {
+        if (in_degree[v] == 0) {
+            order.push_back(v);
+        }
+    }
+    // order doubles as the queue: vertices before head have been expanded
+    for (size_t head = 0; head < order.size(); ++head) {
+        for (uint32_t w : graph.neighbors(order[head])) {
+            if (--in_degree[w] == 0) {
+                order.push_back(w);
+            }
+        }
+    }
+    if (order.size() != n) {
+        throw std::runtime_error("Graph contains a cycle");
+    }
+    return order;
+}
+
+/**
+ * @brief Order the vertices topologically, breaking every tie by the smallest vertex ID
+ * @param graph The graph (directed)
+ * @return The lexicographically smallest topological order
+ * @throw std::invalid_argument if the graph is undirected
+ * @throw std::runtime_error if the graph has a cycle
+ */
+inline std::vector<uint32_t> lexicographic_topological_sort(const CSRGraph& graph) {
+    topological_detail::require_directed(graph);
+    size_t n = graph.vertex_count();
+    std::vector<uint32_t> in_degree(n, 0);
+    for (uint32_t w : graph.targets()) {
+        in_degree[w]++;
+    }
+
+    std::vector<uint32_t> sources;
+    for (uint32_t v = 0; v < n; ++v) {
+        if (in_degree[v] == 0) {
+            sources.push_back(v);
+        }
+    }
+    // Ascending, so it is already a valid min-heap
+    std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> ready(std::greater<uint32_t>(),
+                                                                                      std::move(sources));
+    std::vector<uint32_t> order;
+    order.reserve(n);
+    while (!ready.empty()) {
+        uint32_t v = ready.top();
+        ready.pop();
+        order.push_back(v);
+        for (uint32_t w : graph.neighbors(v)) {
+            if (--in_degree[w] == 0) {
+                ready.push(w);
+            }
+        }
+    }
+    if (order.size() != n) {
+        throw std::runtime_error("Graph contains a cycle");
+    }
+    return order;
+}
+
+/**
+ * @brief Check if a directed graph has no cycle
+ * @param graph The graph (directed)
+ * @return true if a topological order exists, false otherwise
+ * @throw std::invalid_argument if the graph is undirected
+ */
+inline bool is_acyclic(const CSRGraph& graph) {
+    try {
+        topological_sort(graph);
+        return true;
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+}
+
+/**
+ * @brief Compute a topological order level by level, expanding each frontier in parallel
+ * @param graph The graph (directed)
+ * @param threads Worker threads (0 means default_thread_count())
+ * @return The levels; the result is deterministic regardless of the thread count
+ * @throw std::invalid_argument if the graph is undirected
+ * @throw std::runtime_error if the graph has a cycle
+ */
+inline TopologicalLevels topological_levels(const CSRGraph& graph, size_t threads = 0) {
+    topological_detail::require_directed(graph);
+    threads = threads == 0 ? default_thread_count() : threads;
+    size_t n = graph.vertex_count();
+    const auto& targets = graph.targets();
+
+    std::vector<std::atomic<uint32_t>> in_degree(n);
+    parallel_for(0, n, [&](size_t v) {
+        in_degree[v].store(0, std::memory_order_relaxed);
+    }, 1 << 16, threads);
+    parallel_for(0, targets.size(), [&](size_t arc) {
+        in_degree[targets[arc]].fetch_add(1, std::memory_order_relaxed);
+    }, 1 << 16, threads);
+
+    TopologicalLevels result;
+    result.level.assign(n, 0);
+    result.order.reserve(n);
+    result.level_offsets.push_back(0);
+    for (uint32_t v = 0; v < n; ++v) {
+        if (in_degree[v].load(std::memory_order_relaxed) == 0) {
+            result.order.push_back(v);
+        }
+    }
+
+    std::vector<std::vector<uint32_t>> next(threads);
+    size_t begin = 0;
+    uint32_t depth = 0;
+    while (begin < result.order.size()) {
+        size_t end = result.order.size();
+        result.level_offsets.push_back(end);
+        parallel_for_blocks(begin, end, 256, [&](size_t lo, size_t hi, size_t worker) {
+            for (size_t i = lo; i < hi; ++i) {
+                uint32_t v = result.order[i];
+                result.level[v] = depth;
+                for (uint32_t w : graph.neighbors(v)) {
+                    // The thread that removes the last incoming arc owns w
+                    if (in_degree[w].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        next[worker].push_back(w);
+                    }
+                }
+            }
+        }, threads);
+
+        for (auto& found : next) {
+            result.order.insert(result.order.end(), found.begin(), found.end());
+            found.clear();
+        }
+        std::sort(result.order.begin() + static_cast<std::ptrdiff_t>(end), result.order.end());
+        begin = end;
+        depth++;
+    }
+    if (result.order.size() != n) {
+        throw std::runtime_error("Graph contains a cycle");
+    }
+    return result;
+}
+
+#endif // TOPOLOGICAL_SORT_HPP
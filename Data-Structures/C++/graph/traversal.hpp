@@ -0,0 +1,246 @@
+/**
+ * @file traversal.hpp
+ * @brief Visitor-based streaming BFS and DFS over any adjacency-list graph
+ *
+ * Instead of returning every visited vertex, the traversals call hooks of a visitor
+ * passed as a template parameter, so the calls are resolved and inlined at compile time.
+ * A visitor derives from TraversalVisitor and overrides any of:
+ * - discover(v, depth): v is reached for the first time; Prune keeps its edges unexplored
+ * - examine_edge(u, v, arc): an arc is about to be followed; Prune skips it
+ * - finish(v): all arcs of v have been examined
+ * Returning Stop from discover or examine_edge ends the traversal immediately. The arc
+ * argument is the position of the arc within u's neighbor list (for a CSRGraph, its
+ * index in targets() is offsets()[u] + arc).
+ *
+ * The kernels are templates over the graph type. The BFS needs vertex_count() and
+ * for_each_neighbor(v, f), where f may return false to stop the scan; the DFS also needs
+ * degree(v) and cursor(v), a resumable scan with has_next(), left() and next(). CSRGraph
+ * and CompressedGraph provide all of them.
+ *
+ * The queue, stack and visited marks live in a TraversalScratch that can be reused
+ * across traversals; the marks are versioned, so starting a new traversal is O(1)
+ * instead of clearing O(V) memory.
+ *
+ * Time Complexity: O(V' + E') for the V' vertices and E' arcs actually explored
+ *
+ * Space Complexity: O(V) scratch, allocated once per TraversalScratch
+ */
+
+#ifndef TRAVERSAL_HPP
+#define TRAVERSAL_HPP
+
+#include <any>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+
+#include "csr_graph.hpp"
+
+/**
+ * @brief What a visitor hook asks the traversal to do next
+ */
+enum class VisitAction {
+    Continue,   // Proceed normally
+    Prune,      // Do not expand this vertex (discover) or do not follow this arc (examine_edge)
+    Stop        // End the traversal
+};
+
+/**
+ * @brief Visitor with no-op hooks; derive from it and hide the hooks you need
+ */
+struct TraversalVisitor {
+    VisitAction discover(uint32_t, uint32_t) {
+        return VisitAction::Continue;
+    }
+
+    VisitAction examine_edge(uint32_t, uint32_t, uint64_t) {
+        return VisitAction::Continue;
+    }
+
+    void finish(uint32_t) {}
+};
+
+/**
+ * @class TraversalScratch
+ * @brief Reusable working memory for breadth_first_visit() and depth_first_visit()
+ */
+class TraversalScratch {
+private:
+    std::vector<uint32_t> mark;
+    uint32_t epoch = 0;
+    std::any stacks;   // The DFS stack for the cursor type of the last graph searched
+
+public:
+    std::vector<uint32_t> queue;
+
+    /**
+     * @brief Start a new traversal over a graph with vertex_count vertices
+     */
+    void begin(size_t vertex_count) {
+        if (mark.size() < vertex_count) {
+            mark.resize(vertex_count, epoch);
+        }
+        if (++epoch == 0) {
+            // The counter wrapped around: old marks could collide, so clear them once
+            std::fill(mark.begin(), mark.end(), 0);
+            epoch = 1;
+        }
+        queue.clear();
+    }
+
+    /**
+     * @brief Get the empty DFS stack of (vertex, suspended cursor) pairs for a cursor type
+     */
+    template<typename Cursor>
+    std::vector<std::pair<uint32_t, Cursor>>& stack() {
+        using Stack = std::vector<std::pair<uint32_t, Cursor>>;
+        if (Stack* reused = std::any_cast<Stack>(&stacks)) {
+            reused->clear();
+            return *reused;
+        }
+        return stacks.emplace<Stack>();
+    }
+
+    /**
+     * @brief Check if a vertex was reached in the current traversal
+     */
+    bool visited(uint32_t vertex) const {
+        return mark[vertex] == epoch;
+    }
+
+    /**
+     * @brief Mark a vertex as reached in the current traversal
+     */
+    void visit(uint32_t vertex) {
+        mark[vertex] = epoch;
+    }
+};
+
+/**
+ * @brief Breadth-first traversal from a source, reporting events to a visitor
+ * @param graph The graph (CSRGraph, CompressedGraph, or any type with the interface in the file comment)
+ * @param source The source vertex ID
+ * @param visitor The visitor (see TraversalVisitor)
+ * @param scratch Working memory, reusable across calls
+ * @return false if a hook returned Stop, true if the traversal ran to completion
+ * @throw std::out_of_range if the source is not a vertex
+ */
+template<typename Graph, typename Visitor>
+bool breadth_first_visit(const Graph& graph, uint32_t source, Visitor& visitor, TraversalScratch& scratch) {
+    if (source >= graph.vertex_count()) {
+        throw std::out_of_range("Vertex ID is out of range");
+    }
+    scratch.begin(graph.vertex_count());
+    auto& queue = scratch.queue;
+
+    scratch.visit(source);
+    VisitAction action = visitor.discover(source, 0);
+    if (action == VisitAction::Stop) {
+        return false;
+    }
+    if (action == VisitAction::Continue) {
+        queue.push_back(source);
+    } else {
+        visitor.finish(source);
+    }
+
+    uint32_t depth = 0;
+    size_t head = 0;
+    while (head < queue.size()) {
+        size_t level_end = queue.size();
+        depth++;
+        for (; head < level_end; ++head) {
+            uint32_t u = queue[head];
+            uint64_t arc = 0;
+            bool completed = graph.for_each_neighbor(u, [&](uint32_t v, int) {
+                action = visitor.examine_edge(u, v, arc++);
+                if (action == VisitAction::Stop) {
+                    return false;
+                }
+                if (action == VisitAction::Prune || scratch.visited(v)) {
+                    return true;
+                }
+                scratch.visit(v);
+                action = visitor.discover(v, depth);
+                if (action == VisitAction::Stop) {
+                    return false;
+                }
+                if (action == VisitAction::Continue) {
+                    queue.push_back(v);   // Safe: queue[head] was copied into u
+                } else {
+                    visitor.finish(v);
+                }
+                return true;
+            });
+            if (!completed) {
+                return false;
+            }
+            visitor.finish(u);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Depth-first traversal from a source with an explicit stack, reporting events to a visitor
+ * @param graph The graph (CSRGraph, CompressedGraph, or any type with the interface in the file comment)
+ * @param source The source vertex ID
+ * @param visitor The visitor (see TraversalVisitor); depth is the length of the DFS tree path
+ * @param scratch Working memory, reusable across calls
+ * @return false if a hook returned Stop, true if the traversal ran to completion
+ * @throw std::out_of_range if the source is not a vertex
+ */
+template<typename Graph, typename Visitor>
+bool depth_first_visit(const Graph& graph, uint32_t source, Visitor& visitor, TraversalScratch& scratch) {
+    if (source >= graph.vertex_count()) {
+        throw std::out_of_range("Vertex ID is out of range");
+    }
+    scratch.begin(graph.vertex_count());
+    auto& stack = scratch.stack<decltype(graph.cursor(source))>();
+
+    scratch.visit(source);
+    VisitAction action = visitor.discover(source, 0);
+    if (action == VisitAction::Stop) {
+        return false;
+    }
+    if (action == VisitAction::Prune) {
+        visitor.finish(source);
+        return true;
+    }
+    stack.emplace_back(source, graph.cursor(source));
+
+    while (!stack.empty()) {
+        auto& [u, it] = stack.back();
+        if (!it.has_next()) {
+            visitor.finish(u);
+            stack.pop_back();
+            continue;
+        }
+
+        uint32_t from = u;
+        uint64_t arc = graph.degree(u) - it.left();
+        uint32_t v = it.next();
+        action = visitor.examine_edge(from, v, arc);
+        if (action == VisitAction::Stop) {
+            return false;
+        }
+        if (action == VisitAction::Prune || scratch.visited(v)) {
+            continue;
+        }
+        scratch.visit(v);
+        action = visitor.discover(v, static_cast<uint32_t>(stack.size()));
+        if (action == VisitAction::Stop) {
+            return false;
+        }
+        if (action == VisitAction::Continue) {
+            stack.emplace_back(v, graph.cursor(v));   // May reallocate: u and it are not used after this
+        } else {
+            visitor.finish(v);
+        }
+    }
+    return true;
+}
+
+#endif // TRAVERSAL_HPP
@@ -0,0 +1,258 @@
+/**
+ * @file triangle_counting.hpp
+ * @brief Triangle counting and clustering coefficients on an undirected CSRGraph
+ *
+ * Every edge is oriented from the endpoint of lower degree to the one of higher degree
+ * (ties broken by ID). Each triangle is then found exactly once, as u -> v -> w with
+ * w in N+(u) ∩ N+(v), and no vertex's out-list is longer than O(sqrt(E)), which tames
+ * high-degree hubs. The oriented lists stay sorted, so each intersection is a merge;
+ * with SSE2 the merge compares 4x4 blocks of IDs per step. Vertices are processed in
+ * parallel with per-thread counters.
+ *
+ * The graph must be undirected and free of parallel edges (load with deduplicate);
+ * self-loops are ignored.
+ *
+ * Time Complexity: O(E^1.5) worst case, O(E * average out-degree) in practice
+ *
+ * Space Complexity: O(V + E) for the oriented copy
+ */
+
+#ifndef TRIANGLE_COUNTING_HPP
+#define TRIANGLE_COUNTING_HPP
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "csr_graph.hpp"
+#include "../other/parallel_for.hpp"
+
+/**
+ * @brief Count the common elements of two sorted lists of unique IDs
+ * @param a The first list
+ * @param na Its length
+ * @param b The second list
+ * @param nb Its length
+ * @return |a ∩ b|
+ */
+inline uint64_t intersection_size(const uint32_t* a, size_t na, const uint32_t* b, size_t nb) {
+    uint64_t count = 0;
+    size_t i = 0;
+    size_t j = 0;
+
+#if defined(__SSE2__)
+    // Compare a block of 4 from a against a block of 4 from b in all four rotations;
+    // IDs are unique within a list, so every match sets exactly one lane once
+    while (i + 4 <= na && j + 4 <= nb) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        __m128i match = _mm_cmpeq_epi32(va, vb);
+        match = _mm_or_si128(match, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        match = _mm_or_si128(match, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        match = _mm_or_si128(match, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+        count += static_cast<uint64_t>(__builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(match))));
+
+        uint32_t a_max = a[i + 3];
+        uint32_t b_max = b[j + 3];
+        if (a_max <= b_max) {
+            i += 4;
+        }
+        if (b_max <= a_max) {
+            j += 4;
+        }
+    }
+#endif
+
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (a[i] > b[j]) {
+            j++;
+        } else {
+            count++;
+            i++;
+            j++;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Triangle statistics produced by count_triangles()
+ */
+struct TriangleResult {
+    uint64_t triangles = 0;
+    std::vector<uint64_t> per_vertex;   // Triangles through each vertex (only if requested)
+};
+
+namespace triangle_detail {
+
+// Keep only arcs u -> v with (degree(u), u) < (degree(v), v); lists stay sorted by ID
+inline CSRGraph orient_by_degree(const CSRGraph& graph, size_t threads) {
+    size_t n = graph.vertex_count();
+    auto before = [&](uint32_t u, uint32_t v) {
+        size_t du = graph.degree(u);
+        size_t dv = graph.degree(v);
+        return du < dv || (du == dv && u < v);
+    };
+
+    std::vector<uint64_t> offsets(n + 1, 0);
+    parallel_for(0, n, [&](size_t u) {
+        uint64_t kept = 0;
+        for (uint32_t v : graph.neighbors(static_cast<uint32_t>(u))) {
+            kept += before(static_cast<uint32_t>(u), v);
+        }
+        offsets[u + 1] = kept;
+    }, 4096, threads);
+    for (size_t u = 0; u < n; ++u) {
+        offsets[u + 1] += offsets[u];
+    }
+
+    std::vector<uint32_t> targets(offsets[n]);
+    parallel_for(0, n, [&](size_t u) {
+        uint64_t slot = offsets[u];
+        for (uint32_t v : graph.neighbors(static_cast<uint32_t>(u))) {
+            if (before(static_cast<uint32_t>(u), v)) {
+                targets[slot++] = v;
+            }
+        }
+    }, 4096, threads);
+    return CSRGraph(std::move(offsets), std::move(targets), {}, true);
+}
+
+} // namespace triangle_detail
+
+/**
+ * @brief Count the triangles of an undirected graph
+ * @param graph The graph (undirected, no parallel edges)
+ * @param per_vertex Also count the triangles through every vertex
+ * @param threads Worker threads (0 means default_thread_count())
+ * @return The total and, if requested, per-vertex triangle counts
+ * @throw std::invalid_argument if the graph is directed
+ */
+inline TriangleResult count_triangles(const CSRGraph& graph, bool per_vertex = false, size_t threads = 0) {
+    if (graph.is_directed()) {
+        throw std::invalid_argument("Triangle counting requires an undirected graph");
+    }
+    threads = threads == 0 ? default_thread_count() : threads;
+    size_t n = graph.vertex_count();
+    CSRGraph oriented = triangle_detail::orient_by_degree(graph, threads);
+    const auto& offsets = oriented.offsets();
+    const auto& targets = oriented.targets();
+
+    TriangleResult result;
+    std::vector<uint64_t> partial(threads, 0);
+
+    if (!per_vertex) {
+        parallel_for_blocks(0, n, 256, [&](size_t lo, size_t hi, size_t worker) {
+            uint64_t local = 0;
+            for (size_t u = lo; u < hi; ++u) {
+                const uint32_t* out_u = targets.data() + offsets[u];
+                size_t du = offsets[u + 1] - offsets[u];
+                for (size_t k = 0; k < du; ++k) {
+                    uint32_t v = out_u[k];
+                    local += intersection_size(out_u, du, targets.data() + offsets[v], offsets[v + 1] - offsets[v]);
+                }
+            }
+            partial[worker] += local;
+        }, threads);
+    } else {
+        std::vector<std::atomic<uint64_t>> through(n);
+        for (auto& count : through) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        parallel_for_blocks(0, n, 256, [&](size_t lo, size_t hi, size_t worker) {
+            uint64_t local = 0;
+            for (size_t u = lo; u < hi; ++u) {
+                const uint32_t* out_u = targets.data() + offsets[u];
+                size_t du = offsets[u + 1] - offsets[u];
+                uint64_t at_u = 0;
+                for (size_t k = 0; k < du; ++k) {
+                    uint32_t v = out_u[k];
+                    const uint32_t* out_v = targets.data() + offsets[v];
+                    size_t dv = offsets[v + 1] - offsets[v];
+                    uint64_t at_v = 0;
+                    for (size_t i = 0, j = 0; i < du && j < dv;) {
+                        if (out_u[i] < out_v[j]) {
+                            i++;
+                        } else if (out_u[i] > out_v[j]) {
+                            j++;
+                        } else {
+                            through[out_u[i]].fetch_add(1, std::memory_order_relaxed);
+                            at_v++;
+                            i++;
+                            j++;
+                        }
+                    }
+                    if (at_v) {
+                        through[v].fetch_add(at_v, std::memory_order_relaxed);
+                    }
+                    at_u += at_v;
+                }
+                if (at_u) {
+                    through[u].fetch_add(at_u, std::memory_order_relaxed);
+                }
+                local += at_u;
+            }
+            partial[worker] += local;
+        }, threads);
+
+        result.per_vertex.resize(n);
+        for (size_t v = 0; v < n; ++v) {
+            result.per_vertex[v] = through[v].load(std::memory_order_relaxed);
+        }
+    }
+
+    for (uint64_t count : partial) {
+        result.triangles += count;
+    }
+    return result;
+}
+
+/**
+ * @brief Compute the local clustering coefficient of every vertex
+ * @param graph The graph (undirected, no parallel edges)
+ * @param threads Worker threads (0 means default_thread_count())
+ * @return 2 * t(v) / (d(v) * (d(v) - 1)), or 0 for vertices of degree below 2
+ */
+inline std::vector<double> local_clustering_coefficients(const CSRGraph& graph, size_t threads = 0) {
+    TriangleResult triangles = count_triangles(graph, true, threads);
+    std::vector<double> coefficients(graph.vertex_count(), 0.0);
+    for (uint32_t v = 0; v < graph.vertex_count(); ++v) {
+        double degree = 0;
+        for (uint32_t u : graph.neighbors(v)) {
+            degree += (u != v);
+        }
+        if (degree >= 2) {
+            coefficients[v] = 2.0 * static_cast<double>(triangles.per_vertex[v]) / (degree * (degree - 1));
+        }
+    }
+    return coefficients;
+}
+
+/**
+ * @brief Compute the global clustering coefficient (transitivity)
+ * @param graph The graph (undirected, no parallel edges)
+ * @param threads Worker threads (0 means default_thread_count())
+ * @return 3 * triangles / connected triples, or 0 if there are no triples
+ */
+inline double global_clustering_coefficient(const CSRGraph& graph, size_t threads = 0) {
+    uint64_t triangles = count_triangles(graph, false, threads).triangles;
+    double triples = 0;
+    for (uint32_t v = 0; v < graph.vertex_count(); ++v) {
+        double degree = 0;
+        for (uint32_t u : graph.neighbors(v)) {
+            degree += (u != v);
+        }
+        triples += degree * (degree - 1) / 2;
+    }
+    return triples == 0 ? 0.0 : 3.0 * static_cast<double>(triangles) / triples;
+}
+
+#endif // TRIANGLE_COUNTING_HPP
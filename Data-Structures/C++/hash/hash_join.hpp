@@ -0,0 +1,277 @@
+/**
+ * @file hash_join.hpp
+ * @brief Radix-partitioned parallel equi-join over columnar inputs
+ *
+ * Both key columns are hashed once and scattered into 2^bits partitions by the high
+ * bits of the hash, so that the hash table of each build partition fits in cache.
+ * Matching partitions are then joined independently on worker threads: the build
+ * partition is loaded into a flat chained table (bucket heads plus a next array,
+ * indexed by the low hash bits) and the probe partition is streamed against it.
+ * Keys are only compared when the full 64-bit hashes match.
+ *
+ * Time Complexity:
+ * - Partitioning: O(n + m) for build size n and probe size m
+ * - Build and probe: O(n + m + r) on average for r result pairs
+ *
+ * Space Complexity: O(n + m + r)
+ */
+
+#ifndef HASH_JOIN_HPP
+#define HASH_JOIN_HPP
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <functional>
+#include <utility>
+
+#include "../other/parallel_for.hpp"
+
+/**
+ * @brief Tuning knobs for hash_join()
+ */
+struct HashJoinOptions {
+    size_t threads = 0;                 // Worker threads (0 means default_thread_count())
+    size_t cache_bytes = 256 * 1024;    // Target size of one partition's hash table
+    int radix_bits = -1;                // Partition count exponent (-1 derives it from cache_bytes)
+};
+
+/**
+ * @brief Columns produced by hash_join_materialize()
+ */
+template<typename K, typename B, typename P>
+struct JoinResult {
+    std::vector<K> keys;
+    std::vector<B> build_values;
+    std::vector<P> probe_values;
+};
+
+namespace hash_join_detail {
+
+struct Tuple {
+    uint64_t hash;
+    uint32_t row;
+};
+
+struct PartitionedColumn {
+    std::vector<Tuple> tuples;
+    std::vector<size_t> offsets;    // Partition p occupies tuples[offsets[p], offsets[p + 1])
+};
+
+// Finalizer of MurmurHash3: spreads identity hashes such as std::hash<int> over all bits
+inline uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+inline size_t partition_of(uint64_t hash, int bits) {
+    return bits == 0 ? 0 : static_cast<size_t>(hash >> (64 - bits));
+}
+
+template<typename K, typename Hash>
+PartitionedColumn partition(const std::vector<K>& keys, int bits, size_t threads, const Hash& hasher) {
+    size_t n = keys.size();
+    size_t partitions = size_t(1) << bits;
+    size_t chunk = std::max<size_t>(4096, (n + threads - 1) / threads);
+    size_t chunks = (n + chunk - 1) / chunk;
+
+    PartitionedColumn result;
+    result.tuples.resize(n);
+    result.offsets.assign(partitions + 1, 0);
+
+    // Pass 1: hash every key and build one histogram per chunk
+    std::vector<uint64_t> hashes(n);
+    std::vector<size_t> histograms(chunks * partitions, 0);
+    parallel_for_blocks(0, n, chunk, [&](size_t lo, size_t hi, size_t) {
+        size_t* histogram = &histograms[(lo / chunk) * partitions];
+        for (size_t i = lo; i < hi; ++i) {
+            hashes[i] = mix(hasher(keys[i]));
+            histogram[partition_of(hashes[i], bits)]++;
+        }
+    }, threads);
+
+    // Exclusive prefix sum in (partition, chunk) order gives each chunk its write cursors
+    size_t running = 0;
+    for (size_t p = 0; p < partitions; ++p) {
+        result.offsets[p] = running;
+        for (size_t c = 0; c < chunks; ++c) {
+            size_t count = histograms[c * partitions + p];
+            histograms[c * partitions + p] = running;
+            running += count;
+        }
+    }
+    result.offsets[partitions] = running;
+
+    // Pass 2: scatter; every chunk writes to its own disjoint ranges
+    parallel_for_blocks(0, n, chunk, [&](size_t lo, size_t hi, size_t) {
+        size_t* cursor = &histograms[(lo / chunk) * partitions];
+        for (size_t i = lo; i < hi; ++i) {
+            result.tuples[cursor[partition_of(hashes[i], bits)]++] = {hashes[i], static_cast<uint32_t>(i)};
+        }
+    }, threads);
+
+    return result;
+}
+
+inline int choose_radix_bits(size_t build_rows, const HashJoinOptions& options, size_t threads) {
+    if (options.radix_bits >= 0) {
+        return std::min(options.radix_bits, 16);
+    }
+    // Per build row: one tuple, one chain link and roughly one bucket head
+    size_t table_bytes = build_rows * (sizeof(Tuple) + 2 * sizeof(uint32_t));
+    int bits = 0;
+    while (bits < 14 && (table_bytes >> bits) > options.cache_bytes) {
+        bits++;
+    }
+    // Enough partitions to keep every thread busy once the input is not tiny
+    while (bits < 14 && build_rows > 65536 && (size_t(1) << bits) < 4 * threads) {
+        bits++;
+    }
+    return bits;
+}
+
+} // namespace hash_join_detail
+
+/**
+ * @brief Join two key columns on equality and report every matching pair of row indices
+ * @param build_keys Keys of the build side (preferably the smaller input)
+ * @param probe_keys Keys of the probe side
+ * @param emit Callable invoked as emit(build_row, probe_row, worker) for every match;
+ *             calls from different workers run concurrently
+ * @param options Thread count and partitioning parameters
+ * @param hasher Hash function for K
+ * @throw std::length_error if either input has more than 2^32 - 1 rows
+ */
+template<typename K, typename Emit, typename Hash = std::hash<K>>
+void hash_join_for_each(const std::vector<K>& build_keys, const std::vector<K>& probe_keys, Emit&& emit,
+                        const HashJoinOptions& options = {}, const Hash& hasher = Hash()) {
+    using namespace hash_join_detail;
+    constexpr uint32_t EMPTY = std::numeric_limits<uint32_t>::max();
+
+    if (build_keys.size() >= EMPTY || probe_keys.size() >= EMPTY) {
+        throw std::length_error("hash_join supports at most 2^32 - 1 rows per side");
+    }
+    if (build_keys.empty() || probe_keys.empty()) {
+        return;
+    }
+
+    size_t threads = options.threads == 0 ? default_thread_count() : options.threads;
+    int bits = choose_radix_bits(build_keys.size(), options, threads);
+    PartitionedColumn build = partition(build_keys, bits, threads, hasher);
+    PartitionedColumn probe = partition(probe_keys, bits, threads, hasher);
+
+    size_t partitions = size_t(1) << bits;
+    std::vector<std::vector<uint32_t>> heads(threads);
+    std::vector<std::vector<uint32_t>> next(threads);
+
+    parallel_for_blocks(0, partitions, 1, [&](size_t p, size_t, size_t worker) {
+        const Tuple* build_part = build.tuples.data() + build.offsets[p];
+        const Tuple* probe_part = probe.tuples.data() + probe.offsets[p];
+        size_t build_count = build.offsets[p + 1] - build.offsets[p];
+        size_t probe_count = probe.offsets[p + 1] - probe.offsets[p];
+        if (build_count == 0 || probe_count == 0) {
+            return;
+        }
+
+        size_t buckets = 1;
+        while (buckets < build_count) {
+            buckets <<= 1;
+        }
+        size_t mask = buckets - 1;
+
+        auto& head = heads[worker];
+        auto& link = next[worker];
+        head.assign(buckets, EMPTY);
+        link.resize(build_count);
+
+        for (size_t i = 0; i < build_count; ++i) {
+            size_t bucket = build_part[i].hash & mask;
+            link[i] = head[bucket];
+            head[bucket] = static_cast<uint32_t>(i);
+        }
+
+        for (size_t i = 0; i < probe_count; ++i) {
+            const Tuple& tuple = probe_part[i];
+            for (uint32_t j = head[tuple.hash & mask]; j != EMPTY; j = link[j]) {
+                if (build_part[j].hash == tuple.hash && build_keys[build_part[j].row] == probe_keys[tuple.row]) {
+                    emit(static_cast<size_t>(build_part[j].row), static_cast<size_t>(tuple.row), worker);
+                }
+            }
+        }
+    }, threads);
+}
+
+/**
+ * @brief Join two key columns on equality
+ * @param build_keys Keys of the build side (preferably the smaller input)
+ * @param probe_keys Keys of the probe side
+ * @param options Thread count and partitioning parameters
+ * @param hasher Hash function for K
+ * @return (build_row, probe_row) pairs of all matches, grouped by partition rather than sorted
+ */
+template<typename K, typename Hash = std::hash<K>>
+std::vector<std::pair<size_t, size_t>> hash_join(const std::vector<K>& build_keys, const std::vector<K>& probe_keys,
+                                                 const HashJoinOptions& options = {}, const Hash& hasher = Hash()) {
+    size_t threads = options.threads == 0 ? default_thread_count() : options.threads;
+    std::vector<std::vector<std::pair<size_t, size_t>>> per_worker(threads);
+
+    HashJoinOptions fixed = options;
+    fixed.threads = threads;
+    hash_join_for_each(build_keys, probe_keys, [&](size_t build_row, size_t probe_row, size_t worker) {
+        per_worker[worker].emplace_back(build_row, probe_row);
+    }, fixed, hasher);
+
+    if (threads == 1) {
+        return std::move(per_worker[0]);
+    }
+
+    std::vector<std::pair<size_t, size_t>> result;
+    size_t total = 0;
+    for (const auto& pairs : per_worker) {
+        total += pairs.size();
+    }
+    result.reserve(total);
+    for (const auto& pairs : per_worker) {
+        result.insert(result.end(), pairs.begin(), pairs.end());
+    }
+    return result;
+}
+
+/**
+ * @brief Join two tables given as key and payload columns and materialize the output rows
+ * @param build_keys Keys of the build side
+ * @param build_values Payload column of the build side, aligned with build_keys
+ * @param probe_keys Keys of the probe side
+ * @param probe_values Payload column of the probe side, aligned with probe_keys
+ * @param options Thread count and partitioning parameters
+ * @return Output columns (key, build value, probe value), one row per match
+ * @throw std::invalid_argument if a payload column does not match its key column in length
+ */
+template<typename K, typename B, typename P, typename Hash = std::hash<K>>
+JoinResult<K, B, P> hash_join_materialize(const std::vector<K>& build_keys, const std::vector<B>& build_values,
+                                          const std::vector<K>& probe_keys, const std::vector<P>& probe_values,
+                                          const HashJoinOptions& options = {}, const Hash& hasher = Hash()) {
+    if (build_keys.size() != build_values.size() || probe_keys.size() != probe_values.size()) {
+        throw std::invalid_argument("Key and value columns must have the same length");
+    }
+
+    std::vector<std::pair<size_t, size_t>> matches = hash_join(build_keys, probe_keys, options, hasher);
+
+    JoinResult<K, B, P> result;
+    result.keys.resize(matches.size());
+    result.build_values.resize(matches.size());
+    result.probe_values.resize(matches.size());
+    parallel_for(0, matches.size(), [&](size_t i) {
+        result.keys[i] = probe_keys[matches[i].second];
+        result.build_values[i] = build_values[matches[i].first];
+        result.probe_values[i] = probe_values[matches[i].second];
+    }, 4096, options.threads);
+    return result;
+}
+
+#endif // HASH_JOIN_HPP
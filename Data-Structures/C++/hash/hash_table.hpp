@@ -12,6 +12,12 @@
  * - Search: O(1) average case, O(n) worst case
  * 
  * Space Complexity: O(n)
+ *
+ * Instrumentation:
+ * Define HASH_TABLE_STATS before including this header to record probe and chain
+ * lengths, load factor samples, resize events, hit/miss counts and allocated bytes.
+ * The counters are read through stats(). Without the macro no counters are stored
+ * and the recording hooks compile to nothing.
  */
 
 #ifndef HASH_TABLE_HPP
@@ -22,6 +28,55 @@
 #include <stdexcept>
 #include <functional>
 
+#ifdef HASH_TABLE_STATS
+#include <algorithm>
+#include <chrono>
+#include <deque>
+
+#ifndef HASH_TABLE_STATS_MAX_PROBE
+#define HASH_TABLE_STATS_MAX_PROBE 32
+#endif
+
+#ifndef HASH_TABLE_STATS_SAMPLE_INTERVAL
+#define HASH_TABLE_STATS_SAMPLE_INTERVAL 1024
+#endif
+
+#ifndef HASH_TABLE_STATS_MAX_SAMPLES
+#define HASH_TABLE_STATS_MAX_SAMPLES 1024
+#endif
+
+/**
+ * @brief Snapshot of the counters recorded by a HashTable built with HASH_TABLE_STATS
+ */
+struct HashTableStats {
+    struct LoadFactorSample {
+        size_t operation;   // Number of operations performed when the sample was taken
+        float load_factor;
+    };
+
+    struct ResizeEvent {
+        size_t old_size;
+        size_t new_size;
+        size_t entries;
+        std::chrono::nanoseconds duration;
+    };
+
+    // probe_length_histogram[i]: lookups that compared i keys (last slot counts longer probes)
+    std::vector<size_t> probe_length_histogram;
+    // chain_length_histogram[i]: buckets holding i entries at snapshot time (last slot counts longer chains)
+    std::vector<size_t> chain_length_histogram;
+    // Most recent samples, oldest first
+    std::vector<LoadFactorSample> load_factor_samples;
+    std::vector<ResizeEvent> resize_events;
+    size_t operations = 0;
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t bytes_allocated = 0;   // Total bytes requested for buckets and entries since construction or the last reset_stats()
+    size_t bytes_in_use = 0;      // Estimated footprint of the current buckets and entries
+    float load_factor = 0.0f;
+};
+#endif
+
 template<typename K, typename V>
 class HashTable {
 private:
@@ -38,21 +93,83 @@ private:
     float load_factor;
     std::hash<K> hash_function;
 
+    // Approximate per-entry cost of a std::list node: the entry plus two links
+    static constexpr size_t node_bytes = sizeof(Entry) + 2 * sizeof(void*);
+
+#ifdef HASH_TABLE_STATS
+    std::vector<size_t> probe_histogram = std::vector<size_t>(HASH_TABLE_STATS_MAX_PROBE + 1);
+    std::deque<HashTableStats::LoadFactorSample> load_samples;
+    std::vector<HashTableStats::ResizeEvent> resize_events;
+    size_t operations = 0;
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t bytes_allocated = 0;
+#endif
+
     size_t get_index(const K& key) const {
         return hash_function(key) % size;
     }
 
+    /**
+     * @brief Record one lookup that compared `probes` keys and either found its key or not
+     */
+    void record_lookup(size_t probes, bool hit) {
+#ifdef HASH_TABLE_STATS
+        probe_histogram[std::min<size_t>(probes, HASH_TABLE_STATS_MAX_PROBE)]++;
+        if (hit) {
+            hits++;
+        } else {
+            misses++;
+        }
+        if (++operations % HASH_TABLE_STATS_SAMPLE_INTERVAL == 0) {
+            record_load_factor();
+        }
+#else
+        (void)probes;
+        (void)hit;
+#endif
+    }
+
+    void record_allocation(size_t bytes) {
+#ifdef HASH_TABLE_STATS
+        bytes_allocated += bytes;
+#else
+        (void)bytes;
+#endif
+    }
+
+#ifdef HASH_TABLE_STATS
+    void record_load_factor() {
+        if (load_samples.size() == HASH_TABLE_STATS_MAX_SAMPLES) {
+            load_samples.pop_front();
+        }
+        load_samples.push_back({operations, static_cast<float>(count) / size});
+    }
+#endif
+
     void resize() {
-        std::vector<std::list<Entry>> old_table = table;
+#ifdef HASH_TABLE_STATS
+        auto started = std::chrono::steady_clock::now();
+        size_t old_size = size;
+#endif
+        std::vector<std::list<Entry>> old_table(size * 2);
+        table.swap(old_table);
         size *= 2;
-        table = std::vector<std::list<Entry>>(size);
-        count = 0;
+        record_allocation(size * sizeof(std::list<Entry>));
 
-        for (const auto& bucket : old_table) {
-            for (const auto& entry : bucket) {
-                insert(entry.key, entry.value);
+        // Relink the existing nodes instead of copying them
+        for (auto& bucket : old_table) {
+            while (!bucket.empty()) {
+                auto& target = table[get_index(bucket.front().key)];
+                target.splice(target.end(), bucket, bucket.begin());
             }
         }
+
+#ifdef HASH_TABLE_STATS
+        resize_events.push_back({old_size, size, count,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started)});
+        record_load_factor();
+#endif
     }
 
 public:
@@ -64,6 +181,7 @@ public:
     HashTable(size_t initial_size = 10, float load_factor = 0.75)
         : size(initial_size), count(0), load_factor(load_factor) {
         table = std::vector<std::list<Entry>>(size);
+        record_allocation(size * sizeof(std::list<Entry>));
     }
 
     /**
@@ -80,15 +198,20 @@ public:
         auto& bucket = table[index];
 
         // Check if key already exists
+        size_t probes = 0;
         for (auto& entry : bucket) {
+            probes++;
             if (entry.key == key) {
                 entry.value = value;
+                record_lookup(probes, true);
                 return;
             }
         }
 
         bucket.emplace_back(key, value);
         count++;
+        record_lookup(probes, false);
+        record_allocation(node_bytes);
     }
 
     /**
@@ -100,14 +223,18 @@ public:
         size_t index = get_index(key);
         auto& bucket = table[index];
 
+        size_t probes = 0;
         for (auto it = bucket.begin(); it != bucket.end(); ++it) {
+            probes++;
             if (it->key == key) {
                 bucket.erase(it);
                 count--;
+                record_lookup(probes, true);
                 return true;
             }
         }
 
+        record_lookup(probes, false);
         return false;
     }
 
@@ -120,12 +247,16 @@ public:
         size_t index = get_index(key);
         auto& bucket = table[index];
 
+        size_t probes = 0;
         for (auto& entry : bucket) {
+            probes++;
             if (entry.key == key) {
+                record_lookup(probes, true);
                 return &entry.value;
             }
         }
 
+        record_lookup(probes, false);
         return nullptr;
     }
 
@@ -151,6 +282,7 @@ public:
     void clear() {
         table = std::vector<std::list<Entry>>(size);
         count = 0;
+        record_allocation(size * sizeof(std::list<Entry>));
     }
 
     /**
@@ -194,6 +326,40 @@ public:
         }
         return result;
     }
+
+#ifdef HASH_TABLE_STATS
+    /**
+     * @brief Take a snapshot of the instrumentation counters
+     * @return The counters recorded since construction or the last reset_stats()
+     */
+    HashTableStats stats() const {
+        HashTableStats snapshot;
+        snapshot.probe_length_histogram = probe_histogram;
+        snapshot.chain_length_histogram.assign(HASH_TABLE_STATS_MAX_PROBE + 1, 0);
+        for (const auto& bucket : table) {
+            snapshot.chain_length_histogram[std::min<size_t>(bucket.size(), HASH_TABLE_STATS_MAX_PROBE)]++;
+        }
+        snapshot.load_factor_samples.assign(load_samples.begin(), load_samples.end());
+        snapshot.resize_events = resize_events;
+        snapshot.operations = operations;
+        snapshot.hits = hits;
+        snapshot.misses = misses;
+        snapshot.bytes_allocated = bytes_allocated;
+        snapshot.bytes_in_use = size * sizeof(std::list<Entry>) + count * node_bytes;
+        snapshot.load_factor = static_cast<float>(count) / size;
+        return snapshot;
+    }
+
+    /**
+     * @brief Reset the operation counters, keeping the table contents
+     */
+    void reset_stats() {
+        probe_histogram.assign(HASH_TABLE_STATS_MAX_PROBE + 1, 0);
+        load_samples.clear();
+        resize_events.clear();
+        operations = hits = misses = bytes_allocated = 0;
+    }
+#endif
 };
 
 #endif // HASH_TABLE_HPP 
\ No newline at end of file
@@ -0,0 +1,206 @@
+/**
+ * @file disjoint_set.hpp
+ * @brief Disjoint set (union-find) over dense integer IDs
+ *
+ * DisjointSet is the classic sequential structure with union by size and path halving.
+ * ConcurrentDisjointSet can be shared by many threads: roots are linked with a
+ * compare-and-swap from the larger ID to the smaller one, and finds shorten paths by
+ * path splitting (every visited node is pointed at its grandparent). DisjointSet
+ * also grows with add() so it can track a set of elements that is still being built.
+ *
+ * Time Complexity:
+ * - Find: O(α(n)) amortized
+ * - Unite: O(α(n)) amortized
+ * - Add element: O(1) amortized
+ *
+ * Space Complexity: O(n)
+ */
+
+#ifndef DISJOINT_SET_HPP
+#define DISJOINT_SET_HPP
+
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+
+class DisjointSet {
+private:
+    std::vector<uint32_t> parent;
+    std::vector<uint32_t> set_size;
+    size_t sets;
+
+public:
+    /**
+     * @brief Constructor
+     * @param count Number of singleton sets to start with (IDs 0 .. count - 1)
+     */
+    explicit DisjointSet(size_t count = 0) : parent(count), set_size(count, 1), sets(count) {
+        std::iota(parent.begin(), parent.end(), 0);
+    }
+
+    /**
+     * @brief Add a new singleton set
+     * @return The ID of the new element
+     */
+    uint32_t add() {
+        parent.push_back(static_cast<uint32_t>(parent.size()));
+        set_size.push_back(1);
+        sets++;
+        return parent.back();
+    }
+
+    /**
+     * @brief Find the representative of an element's set
+     * @param x The element ID
+     * @return The root of the set containing x
+     */
+    uint32_t find(uint32_t x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    /**
+     * @brief Merge the sets containing two elements
+     * @param a The first element ID
+     * @param b The second element ID
+     * @return true if two different sets were merged, false if they were already one
+     */
+    bool unite(uint32_t a, uint32_t b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return false;
+        }
+        if (set_size[a] < set_size[b]) {
+            std::swap(a, b);
+        }
+        parent[b] = a;
+        set_size[a] += set_size[b];
+        sets--;
+        return true;
+    }
+
+    /**
+     * @brief Check if two elements are in the same set
+     */
+    bool connected(uint32_t a, uint32_t b) {
+        return find(a) == find(b);
+    }
+
+    /**
+     * @brief Get the size of the set containing an element
+     */
+    size_t size_of(uint32_t x) {
+        return set_size[find(x)];
+    }
+
+    /**
+     * @brief Get the number of elements
+     */
+    size_t size() const {
+        return parent.size();
+    }
+
+    /**
+     * @brief Get the number of disjoint sets
+     */
+    size_t set_count() const {
+        return sets;
+    }
+
+    /**
+     * @brief Make every element a singleton set again
+     */
+    void reset() {
+        std::iota(parent.begin(), parent.end(), 0);
+        std::fill(set_size.begin(), set_size.end(), 1);
+        sets = parent.size();
+    }
+};
+
+class ConcurrentDisjointSet {
+private:
+    std::vector<std::atomic<uint32_t>> parent;
+
+public:
+    /**
+     * @brief Constructor
+     * @param count Number of singleton sets (IDs 0 .. count - 1)
+     */
+    explicit ConcurrentDisjointSet(size_t count) : parent(count) {
+        for (size_t i = 0; i < count; ++i) {
+            parent[i].store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Find the representative of an element's set (safe to call concurrently)
+     * @param x The element ID
+     * @return The current root of the set containing x
+     */
+    uint32_t find(uint32_t x) {
+        while (true) {
+            uint32_t p = parent[x].load(std::memory_order_relaxed);
+            uint32_t grandparent = parent[p].load(std::memory_order_relaxed);
+            if (p == grandparent) {
+                return p;
+            }
+            // Path splitting; losing the race only means the path stays longer
+            parent[x].compare_exchange_weak(p, grandparent, std::memory_order_relaxed);
+            x = grandparent;
+        }
+    }
+
+    /**
+     * @brief Merge the sets containing two elements (safe to call concurrently)
+     * @param a The first element ID
+     * @param b The second element ID
+     * @return true if this call linked two different roots
+     */
+    bool unite(uint32_t a, uint32_t b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) {
+                return false;
+            }
+            // Always hang the larger root under the smaller one, so links cannot form cycles
+            if (a < b) {
+                std::swap(a, b);
+            }
+            uint32_t expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    /**
+     * @brief Get the parent of an element without compressing (for single-threaded passes)
+     */
+    uint32_t parent_of(uint32_t x) const {
+        return parent[x].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Point an element directly at a root (for single-writer compression passes)
+     */
+    void set_parent(uint32_t x, uint32_t root) {
+        parent[x].store(root, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of elements
+     */
+    size_t size() const {
+        return parent.size();
+    }
+};
+
+#endif // DISJOINT_SET_HPP
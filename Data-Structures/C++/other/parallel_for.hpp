@@ -0,0 +1,136 @@
+/**
+ * @file parallel_for.hpp
+ * @brief Minimal fork-join helpers built on std::thread
+ * 
+ * The loops split an index range into blocks that worker threads claim from a shared
+ * atomic counter, so uneven blocks (e.g. high-degree vertices) balance themselves.
+ * Every call starts and joins its own threads; ranges smaller than one block run
+ * on the calling thread.
+ * 
+ * Time Complexity:
+ * - Scheduling overhead: O(threads + (end - begin) / grain)
+ * 
+ * Space Complexity: O(threads)
+ */
+
+#ifndef PARALLEL_FOR_HPP
+#define PARALLEL_FOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+#include <utility>
+
+/**
+ * @brief Get the number of worker threads to use by default
+ * @return The number of hardware threads, at least 1
+ */
+inline size_t default_thread_count() {
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Run body(block_begin, block_end, worker) over [begin, end) split into blocks of `grain`
+ * @param begin First index of the range
+ * @param end One past the last index of the range
+ * @param grain Number of indices per block
+ * @param body Callable invoked once per block; `worker` is in [0, threads)
+ * @param threads Number of worker threads (0 means default_thread_count())
+ */
+template<typename F>
+void parallel_for_blocks(size_t begin, size_t end, size_t grain, F&& body, size_t threads = 0) {
+    if (begin >= end) {
+        return;
+    }
+    grain = std::max<size_t>(1, grain);
+    if (threads == 0) {
+        threads = default_thread_count();
+    }
+    size_t blocks = (end - begin + grain - 1) / grain;
+    threads = std::min(threads, blocks);
+
+    if (threads <= 1) {
+        for (size_t lo = begin; lo < end; lo += grain) {
+            body(lo, std::min(end, lo + grain), size_t(0));
+        }
+        return;
+    }
+
+    std::atomic<size_t> next_block(0);
+    auto worker = [&](size_t id) {
+        for (size_t block = next_block.fetch_add(1); block < blocks; block = next_block.fetch_add(1)) {
+            size_t lo = begin + block * grain;
+            body(lo, std::min(end, lo + grain), id);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (size_t id = 1; id < threads; ++id) {
+        pool.emplace_back(worker, id);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief Run two callables, the first on its own thread when fork is true
+ *
+ * For recursive divide-and-conquer: callers bound the recursion depth at which they
+ * fork, so the number of live threads stays near the number of cores.
+ *
+ * @param first Callable run on a new thread (or inline when fork is false)
+ * @param second Callable run on the calling thread
+ * @param fork Whether to run the two in parallel
+ * @throw Whatever first or second throws, after both have finished; if both throw,
+ *        the exception of second is propagated
+ */
+template<typename F, typename G>
+void parallel_invoke(F&& first, G&& second, bool fork = true) {
+    if (!fork) {
+        first();
+        second();
+        return;
+    }
+    std::exception_ptr forked_error;
+    std::thread thread([&first, &forked_error] {
+        try {
+            first();
+        } catch (...) {
+            forked_error = std::current_exception();
+        }
+    });
+    try {
+        second();
+    } catch (...) {
+        thread.join();
+        throw;
+    }
+    thread.join();
+    if (forked_error) {
+        std::rethrow_exception(forked_error);
+    }
+}
+
+/**
+ * @brief Run body(i) for every i in [begin, end) in parallel
+ * @param begin First index of the range
+ * @param end One past the last index of the range
+ * @param body Callable invoked once per index
+ * @param grain Number of indices handed to a thread at a time
+ * @param threads Number of worker threads (0 means default_thread_count())
+ */
+template<typename F>
+void parallel_for(size_t begin, size_t end, F&& body, size_t grain = 1024, size_t threads = 0) {
+    parallel_for_blocks(begin, end, grain, [&](size_t lo, size_t hi, size_t) {
+        for (size_t i = lo; i < hi; ++i) {
+            body(i);
+        }
+    }, threads);
+}
+
+#endif // PARALLEL_FOR_HPP
@@ -4,11 +4,31 @@
  * 
  * An AVL tree is a self-balancing binary search tree where the heights of the left and right
  * subtrees of any node differ by at most one.
+ *
+ * Every node also stores the size of its subtree, which answers order-statistic queries
+ * (rank, k-th smallest, number of keys in a range) with one root-to-leaf walk.
+ *
+ * The nodes, rotations and rebalancing in avl_detail are shared with other trees built
+ * on AVL balancing (see interval_tree.hpp). Node takes an augmentation policy: a class
+ * whose fields every node inherits and whose static update(node) recomputes them from
+ * the children whenever height and size are refreshed, including after every rotation.
+ *
+ * Bulk operations are built on join(L, k, R), which links two trees and a middle key
+ * (all keys of L <= k <= all keys of R) by walking down the spine of the taller tree
+ * and rebalancing on the way back. split, union, intersection and difference follow
+ * Blelloch, Ferizovic and Sun, "Just Join for Parallel Ordered Sets" (SPAA 2016): the
+ * set operations split one tree by the other's root and recurse into both halves as
+ * independent tasks, forking threads near the top of the recursion.
  * 
  * Time Complexity:
  * - Insert: O(log n)
  * - Delete: O(log n)
  * - Search: O(log n)
+ * - Rank / Select / Range count / Percentile: O(log n)
+ * - Build from sorted input: O(n)
+ * - Join / Split: O(log n)
+ * - Union / Intersection / Difference: O(m log(n / m + 1)) work for sizes m <= n,
+ *   O(log^2 n) span
  * - Traversal: O(n)
  * 
  * Space Complexity: O(n)
@@ -17,67 +37,134 @@
 #ifndef AVL_TREE_HPP
 #define AVL_TREE_HPP
 
+#include <cmath>
 #include <queue>
 #include <vector>
+#include <cstddef>
+#include <algorithm>
 #include <stdexcept>
 #include <functional>
 
-template<typename T>
-class Node {
+#include "../other/parallel_for.hpp"
+
+/**
+ * @brief Augmentation policy for nodes that only keep height and size
+ */
+struct AVLNoAugmentation {
+    template<typename N>
+    static void update(N*) {}
+};
+
+template<typename T, typename Augment = AVLNoAugmentation>
+class Node : public Augment {
 public:
+    using Augmentation = Augment;
+
     T data;
     Node* left;
     Node* right;
     int height;
+    size_t size;
     
-    Node(const T& data) : data(data), left(nullptr), right(nullptr), height(1) {}
+    Node(const T& data) : data(data), left(nullptr), right(nullptr), height(1), size(1) {
+        Augment::update(this);
+    }
 };
 
-template<typename T>
-class AVLTree {
-private:
-    Node<T>* root;
+namespace avl_detail {
 
-    int get_height(Node<T>* node) const {
-        if (node == nullptr) {
-            return 0;
-        }
-        return node->height;
-    }
+template<typename N>
+int height(const N* node) {
+    return node ? node->height : 0;
+}
 
-    int get_balance(Node<T>* node) const {
-        if (node == nullptr) {
-            return 0;
-        }
-        return get_height(node->left) - get_height(node->right);
-    }
+template<typename N>
+size_t size(const N* node) {
+    return node ? node->size : 0;
+}
 
-    Node<T>* right_rotate(Node<T>* y) {
-        Node<T>* x = y->left;
-        Node<T>* T2 = x->right;
+template<typename N>
+int balance(const N* node) {
+    return node ? height(node->left) - height(node->right) : 0;
+}
 
-        x->right = y;
-        y->left = T2;
+// Recompute height, size and the augmented fields of a node from its children
+template<typename N>
+void update(N* node) {
+    node->height = std::max(height(node->left), height(node->right)) + 1;
+    node->size = size(node->left) + size(node->right) + 1;
+    N::Augmentation::update(node);
+}
 
-        y->height = std::max(get_height(y->left), get_height(y->right)) + 1;
-        x->height = std::max(get_height(x->left), get_height(x->right)) + 1;
+template<typename N>
+N* right_rotate(N* y) {
+    N* x = y->left;
+    N* T2 = x->right;
 
-        return x;
-    }
+    x->right = y;
+    y->left = T2;
+
+    update(y);
+    update(x);
+
+    return x;
+}
+
+template<typename N>
+N* left_rotate(N* x) {
+    N* y = x->right;
+    N* T2 = y->left;
+
+    y->left = x;
+    x->right = T2;
+
+    update(x);
+    update(y);
 
-    Node<T>* left_rotate(Node<T>* x) {
-        Node<T>* y = x->right;
-        Node<T>* T2 = y->left;
+    return y;
+}
 
-        y->left = x;
-        x->right = T2;
+// Refresh a node whose subtrees were just changed by an insert or delete below it, and
+// rotate if their heights now differ by two. The case is decided by the child's balance
+// rather than by comparing keys, so inserting a duplicate (which goes right) still rebalances
+template<typename N>
+N* rebalance(N* node) {
+    update(node);
 
-        x->height = std::max(get_height(x->left), get_height(x->right)) + 1;
-        y->height = std::max(get_height(y->left), get_height(y->right)) + 1;
+    int node_balance = balance(node);
 
-        return y;
+    // Left Left Case
+    if (node_balance > 1 && balance(node->left) >= 0) {
+        return right_rotate(node);
     }
 
+    // Left Right Case
+    if (node_balance > 1 && balance(node->left) < 0) {
+        node->left = left_rotate(node->left);
+        return right_rotate(node);
+    }
+
+    // Right Right Case
+    if (node_balance < -1 && balance(node->right) <= 0) {
+        return left_rotate(node);
+    }
+
+    // Right Left Case
+    if (node_balance < -1 && balance(node->right) > 0) {
+        node->right = right_rotate(node->right);
+        return left_rotate(node);
+    }
+
+    return node;
+}
+
+} // namespace avl_detail
+
+template<typename T>
+class AVLTree {
+private:
+    Node<T>* root;
+
     Node<T>* insert_recursive(Node<T>* node, const T& data) {
         if (node == nullptr) {
             return new Node<T>(data);
@@ -89,33 +176,7 @@ private:
             node->right = insert_recursive(node->right, data);
         }
 
-        node->height = std::max(get_height(node->left), get_height(node->right)) + 1;
-
-        int balance = get_balance(node);
-
-        // Left Left Case
-        if (balance > 1 && data < node->left->data) {
-            return right_rotate(node);
-        }
-
-        // Right Right Case
-        if (balance < -1 && data > node->right->data) {
-            return left_rotate(node);
-        }
-
-        // Left Right Case
-        if (balance > 1 && data > node->left->data) {
-            node->left = left_rotate(node->left);
-            return right_rotate(node);
-        }
-
-        // Right Left Case
-        if (balance < -1 && data < node->right->data) {
-            node->right = right_rotate(node->right);
-            return left_rotate(node);
-        }
-
-        return node;
+        return avl_detail::rebalance(node);
     }
 
     Node<T>* delete_recursive(Node<T>* node, const T& data) {
@@ -152,49 +213,267 @@ private:
             return nullptr;
         }
 
-        node->height = std::max(get_height(node->left), get_height(node->right)) + 1;
-
-        int balance = get_balance(node);
+        return avl_detail::rebalance(node);
+    }
 
-        // Left Left Case
-        if (balance > 1 && get_balance(node->left) >= 0) {
-            return right_rotate(node);
+    bool search_recursive(Node<T>* node, const T& data) const {
+        if (node == nullptr) {
+            return false;
         }
 
-        // Left Right Case
-        if (balance > 1 && get_balance(node->left) < 0) {
-            node->left = left_rotate(node->left);
-            return right_rotate(node);
+        if (data == node->data) {
+            return true;
+        } else if (data < node->data) {
+            return search_recursive(node->left, data);
+        } else {
+            return search_recursive(node->right, data);
         }
+    }
 
-        // Right Right Case
-        if (balance < -1 && get_balance(node->right) <= 0) {
-            return left_rotate(node);
+    // Number of keys less than data (or not greater than it, if inclusive)
+    size_t count_below(const T& data, bool inclusive) const {
+        size_t count = 0;
+        Node<T>* current = root;
+        while (current) {
+            bool go_right = inclusive ? !(data < current->data) : current->data < data;
+            if (go_right) {
+                count += avl_detail::size(current->left) + 1;
+                current = current->right;
+            } else {
+                current = current->left;
+            }
         }
+        return count;
+    }
+
+    // Subtrees at least this large are worth a thread when the fork budget allows
+    static constexpr size_t FORK_GRAIN = 1 << 12;
 
-        // Right Left Case
-        if (balance < -1 && get_balance(node->right) > 0) {
-            node->right = right_rotate(node->right);
-            return left_rotate(node);
+    static int fork_depth(size_t threads) {
+        threads = threads == 0 ? default_thread_count() : threads;
+        int depth = 0;
+        while ((size_t(1) << depth) < threads) {
+            depth++;
         }
+        return depth;
+    }
 
+    Node<T>* link(Node<T>* left, Node<T>* node, Node<T>* right) {
+        node->left = left;
+        node->right = right;
+        avl_detail::update(node);
         return node;
     }
 
-    bool search_recursive(Node<T>* node, const T& data) const {
-        if (node == nullptr) {
-            return false;
+    // Join where left is taller: descend its right spine to a subtree of matching height
+    Node<T>* join_right(Node<T>* left, Node<T>* key, Node<T>* right) {
+        Node<T>* l = left->left;
+        Node<T>* c = left->right;
+        if (avl_detail::height(c) <= avl_detail::height(right) + 1) {
+            Node<T>* t = link(c, key, right);
+            if (avl_detail::height(t) <= avl_detail::height(l) + 1) {
+                return link(l, left, t);
+            }
+            return avl_detail::left_rotate(link(l, left, avl_detail::right_rotate(t)));
+        }
+        Node<T>* t = join_right(c, key, right);
+        Node<T>* joined = link(l, left, t);
+        if (avl_detail::height(t) <= avl_detail::height(l) + 1) {
+            return joined;
         }
+        return avl_detail::left_rotate(joined);
+    }
 
-        if (data == node->data) {
-            return true;
-        } else if (data < node->data) {
-            return search_recursive(node->left, data);
+    // Mirror image of join_right, for a taller right tree
+    Node<T>* join_left(Node<T>* left, Node<T>* key, Node<T>* right) {
+        Node<T>* r = right->right;
+        Node<T>* c = right->left;
+        if (avl_detail::height(c) <= avl_detail::height(left) + 1) {
+            Node<T>* t = link(left, key, c);
+            if (avl_detail::height(t) <= avl_detail::height(r) + 1) {
+                return link(t, right, r);
+            }
+            return avl_detail::right_rotate(link(avl_detail::left_rotate(t), right, r));
+        }
+        Node<T>* t = join_left(left, key, c);
+        Node<T>* joined = link(t, right, r);
+        if (avl_detail::height(t) <= avl_detail::height(r) + 1) {
+            return joined;
+        }
+        return avl_detail::right_rotate(joined);
+    }
+
+    // Link left, the single node key and right (left <= key <= right) into one AVL tree
+    Node<T>* join_nodes(Node<T>* left, Node<T>* key, Node<T>* right) {
+        if (avl_detail::height(left) > avl_detail::height(right) + 1) {
+            return join_right(left, key, right);
+        }
+        if (avl_detail::height(right) > avl_detail::height(left) + 1) {
+            return join_left(left, key, right);
+        }
+        return link(left, key, right);
+    }
+
+    Node<T>* remove_last(Node<T>* node, Node<T>*& last) {
+        if (node->right == nullptr) {
+            last = node;
+            return node->left;
+        }
+        Node<T>* rest = remove_last(node->right, last);
+        return join_nodes(node->left, node, rest);
+    }
+
+    // Join without a middle key (left <= right)
+    Node<T>* join_trees(Node<T>* left, Node<T>* right) {
+        if (left == nullptr) {
+            return right;
+        }
+        Node<T>* last = nullptr;
+        Node<T>* rest = remove_last(left, last);
+        return join_nodes(rest, last, right);
+    }
+
+    // Split into keys < data and keys >= data
+    void split_below(Node<T>* node, const T& data, Node<T>*& left, Node<T>*& right) {
+        if (node == nullptr) {
+            left = right = nullptr;
+            return;
+        }
+        Node<T>* l = node->left;
+        Node<T>* r = node->right;
+        Node<T>* middle = nullptr;
+        if (node->data < data) {
+            split_below(r, data, middle, right);
+            left = join_nodes(l, node, middle);
         } else {
-            return search_recursive(node->right, data);
+            split_below(l, data, left, middle);
+            right = join_nodes(middle, node, r);
         }
     }
 
+    // Split into keys < data and keys > data; returns the detached node equal to data, if any
+    Node<T>* split_at(Node<T>* node, const T& data, Node<T>*& left, Node<T>*& right) {
+        if (node == nullptr) {
+            left = right = nullptr;
+            return nullptr;
+        }
+        Node<T>* l = node->left;
+        Node<T>* r = node->right;
+        Node<T>* middle = nullptr;
+        if (data < node->data) {
+            Node<T>* found = split_at(l, data, left, middle);
+            right = join_nodes(middle, node, r);
+            return found;
+        }
+        if (node->data < data) {
+            Node<T>* found = split_at(r, data, middle, right);
+            left = join_nodes(l, node, middle);
+            return found;
+        }
+        left = l;
+        right = r;
+        node->left = node->right = nullptr;
+        return node;
+    }
+
+    Node<T>* build_sorted(const std::vector<T>& sorted, size_t begin, size_t end, int forks) {
+        if (begin >= end) {
+            return nullptr;
+        }
+        size_t middle = begin + (end - begin) / 2;
+        Node<T>* node = new Node<T>(sorted[middle]);
+        Node<T>* left = nullptr;
+        Node<T>* right = nullptr;
+        try {
+            parallel_invoke([&] { left = build_sorted(sorted, begin, middle, forks - 1); },
+                            [&] { right = build_sorted(sorted, middle + 1, end, forks - 1); },
+                            forks > 0 && end - begin >= FORK_GRAIN);
+        } catch (...) {
+            // A failed half has freed its own nodes; free the half that was built
+            clear_recursive(left);
+            clear_recursive(right);
+            delete node;
+            throw;
+        }
+        return link(left, node, right);
+    }
+
+    Node<T>* union_nodes(Node<T>* a, Node<T>* b, int forks) {
+        if (a == nullptr) {
+            return b;
+        }
+        if (b == nullptr) {
+            return a;
+        }
+        bool fork = forks > 0 && avl_detail::size(a) + avl_detail::size(b) >= FORK_GRAIN;
+        Node<T>* l2 = b->left;
+        Node<T>* r2 = b->right;
+        Node<T>* l1 = nullptr;
+        Node<T>* r1 = nullptr;
+        delete split_at(a, b->data, l1, r1);
+        Node<T>* left = nullptr;
+        Node<T>* right = nullptr;
+        parallel_invoke([&] { left = union_nodes(l1, l2, forks - 1); },
+                        [&] { right = union_nodes(r1, r2, forks - 1); }, fork);
+        return join_nodes(left, b, right);
+    }
+
+    Node<T>* intersection_nodes(Node<T>* a, Node<T>* b, int forks) {
+        if (a == nullptr || b == nullptr) {
+            clear_recursive(a);
+            clear_recursive(b);
+            return nullptr;
+        }
+        bool fork = forks > 0 && avl_detail::size(a) + avl_detail::size(b) >= FORK_GRAIN;
+        Node<T>* l2 = b->left;
+        Node<T>* r2 = b->right;
+        Node<T>* l1 = nullptr;
+        Node<T>* r1 = nullptr;
+        Node<T>* found = split_at(a, b->data, l1, r1);
+        Node<T>* left = nullptr;
+        Node<T>* right = nullptr;
+        parallel_invoke([&] { left = intersection_nodes(l1, l2, forks - 1); },
+                        [&] { right = intersection_nodes(r1, r2, forks - 1); }, fork);
+        if (found) {
+            delete found;
+            return join_nodes(left, b, right);
+        }
+        delete b;
+        return join_trees(left, right);
+    }
+
+    Node<T>* difference_nodes(Node<T>* a, Node<T>* b, int forks) {
+        if (a == nullptr) {
+            clear_recursive(b);
+            return nullptr;
+        }
+        if (b == nullptr) {
+            return a;
+        }
+        bool fork = forks > 0 && avl_detail::size(a) + avl_detail::size(b) >= FORK_GRAIN;
+        Node<T>* l2 = b->left;
+        Node<T>* r2 = b->right;
+        Node<T>* l1 = nullptr;
+        Node<T>* r1 = nullptr;
+        delete split_at(a, b->data, l1, r1);
+        delete b;
+        Node<T>* left = nullptr;
+        Node<T>* right = nullptr;
+        parallel_invoke([&] { left = difference_nodes(l1, l2, forks - 1); },
+                        [&] { right = difference_nodes(r1, r2, forks - 1); }, fork);
+        return join_trees(left, right);
+    }
+
+    Node<T>* copy_recursive(Node<T>* node) const {
+        if (node == nullptr) {
+            return nullptr;
+        }
+        Node<T>* copy = new Node<T>(*node);
+        copy->left = copy_recursive(node->left);
+        copy->right = copy_recursive(node->right);
+        return copy;
+    }
+
     void clear_recursive(Node<T>* node) {
         if (node) {
             clear_recursive(node->left);
@@ -209,6 +488,30 @@ public:
      */
     AVLTree() : root(nullptr) {}
 
+    /**
+     * @brief Copy constructor (deep copy)
+     * @param other The AVL tree to copy
+     */
+    AVLTree(const AVLTree& other) : root(copy_recursive(other.root)) {}
+
+    /**
+     * @brief Move constructor
+     * @param other The AVL tree to take the nodes from; left empty
+     */
+    AVLTree(AVLTree&& other) noexcept : root(other.root) {
+        other.root = nullptr;
+    }
+
+    /**
+     * @brief Copy or move assignment
+     * @param other The AVL tree to take the contents of
+     * @return This AVL tree
+     */
+    AVLTree& operator=(AVLTree other) noexcept {
+        std::swap(root, other.root);
+        return *this;
+    }
+
     /**
      * @brief Destructor
      */
@@ -224,6 +527,14 @@ public:
         return root == nullptr;
     }
 
+    /**
+     * @brief Get the number of keys in the AVL tree
+     * @return The number of keys, counting duplicates
+     */
+    size_t size() const {
+        return avl_detail::size(root);
+    }
+
     /**
      * @brief Insert a new node into the AVL tree
      * @param data The data to be inserted
@@ -348,6 +659,148 @@ public:
         return current->data;
     }
 
+    /**
+     * @brief Get the rank of a value
+     * @param data The value (need not be in the tree)
+     * @return The number of keys strictly less than data
+     */
+    size_t rank(const T& data) const {
+        return count_below(data, false);
+    }
+
+    /**
+     * @brief Get the k-th smallest key
+     * @param k The zero-based position in sorted order
+     * @return The key with exactly k keys before it in sorted order
+     * @throw std::out_of_range if k >= size()
+     */
+    T select(size_t k) const {
+        if (k >= size()) {
+            throw std::out_of_range("Rank is out of range");
+        }
+
+        Node<T>* current = root;
+        while (true) {
+            size_t left_size = avl_detail::size(current->left);
+            if (k < left_size) {
+                current = current->left;
+            } else if (k == left_size) {
+                return current->data;
+            } else {
+                k -= left_size + 1;
+                current = current->right;
+            }
+        }
+    }
+
+    /**
+     * @brief Count the keys in the closed range [low, high]
+     * @param low The lower bound
+     * @param high The upper bound
+     * @return The number of keys k with low <= k <= high (0 if low > high)
+     */
+    size_t count_range(const T& low, const T& high) const {
+        if (high < low) {
+            return 0;
+        }
+        return count_below(high, true) - count_below(low, false);
+    }
+
+    /**
+     * @brief Get a percentile of the keys (nearest-rank method)
+     * @param percent The percentile, in [0, 100]
+     * @return The smallest key with at least percent% of the keys at or below it
+     * @throw std::runtime_error if the AVL tree is empty
+     * @throw std::invalid_argument if percent is outside [0, 100]
+     */
+    T percentile(double percent) const {
+        if (is_empty()) {
+            throw std::runtime_error("AVL tree is empty");
+        }
+        if (!(percent >= 0.0 && percent <= 100.0)) {
+            throw std::invalid_argument("Percentile must be in [0, 100]");
+        }
+
+        size_t n = size();
+        size_t k = static_cast<size_t>(std::ceil(percent / 100.0 * static_cast<double>(n)));
+        return select(k == 0 ? 0 : std::min(k, n) - 1);
+    }
+
+    /**
+     * @brief Build an AVL tree from sorted keys in O(n), without rebalancing
+     * @param sorted Keys in non-decreasing order
+     * @param threads Worker threads (0 means default_thread_count())
+     * @return A perfectly balanced AVL tree holding the keys
+     * @throw std::invalid_argument if the keys are not sorted
+     */
+    static AVLTree from_sorted(const std::vector<T>& sorted, size_t threads = 0) {
+        if (!std::is_sorted(sorted.begin(), sorted.end())) {
+            throw std::invalid_argument("Keys must be sorted");
+        }
+
+        AVLTree tree;
+        tree.root = tree.build_sorted(sorted, 0, sorted.size(), fork_depth(threads));
+        return tree;
+    }
+
+    /**
+     * @brief Append every key of another AVL tree, none of which may be smaller than this tree's keys
+     * @param other The AVL tree to append (pass with std::move to avoid a copy)
+     * @throw std::invalid_argument if other holds a key smaller than get_max()
+     */
+    void join(AVLTree other) {
+        if (!is_empty() && !other.is_empty() && other.get_min() < get_max()) {
+            throw std::invalid_argument("Joined keys must not be smaller than existing keys");
+        }
+
+        root = join_trees(root, other.root);
+        other.root = nullptr;
+    }
+
+    /**
+     * @brief Move the keys not less than a pivot into a new AVL tree
+     * @param data The pivot
+     * @return The AVL tree of keys >= data; this tree keeps the keys < data
+     */
+    AVLTree split(const T& data) {
+        AVLTree upper;
+        split_below(root, data, root, upper.root);
+        return upper;
+    }
+
+    /**
+     * @brief Add every key of another AVL tree that is not already present
+     *
+     * The set operations treat both trees as sets of distinct keys.
+     *
+     * @param other The AVL tree to merge in (pass with std::move to avoid a copy)
+     * @param threads Worker threads (0 means default_thread_count())
+     */
+    void union_with(AVLTree other, size_t threads = 0) {
+        root = union_nodes(root, other.root, fork_depth(threads));
+        other.root = nullptr;
+    }
+
+    /**
+     * @brief Keep only the keys also present in another AVL tree
+     * @param other The AVL tree to intersect with (pass with std::move to avoid a copy)
+     * @param threads Worker threads (0 means default_thread_count())
+     */
+    void intersect_with(AVLTree other, size_t threads = 0) {
+        root = intersection_nodes(root, other.root, fork_depth(threads));
+        other.root = nullptr;
+    }
+
+    /**
+     * @brief Remove every key present in another AVL tree
+     * @param other The AVL tree of keys to remove (pass with std::move to avoid a copy)
+     * @param threads Worker threads (0 means default_thread_count())
+     */
+    void difference_with(AVLTree other, size_t threads = 0) {
+        root = difference_nodes(root, other.root, fork_depth(threads));
+        other.root = nullptr;
+    }
+
     /**
      * @brief Remove all nodes from the AVL tree
      */
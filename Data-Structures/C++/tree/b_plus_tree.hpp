@@ -0,0 +1,768 @@
+/**
+ * @file b_plus_tree.hpp
+ * @brief B+ tree ordered set with cache-line-sized nodes, linked leaves and bulk loading
+ *
+ * A B+ tree stores keys only in its leaves, which are chained left to right; inner
+ * nodes hold separator keys (the smallest key of every child but the first) that route
+ * a search. Nodes are NodeBytes long (a multiple of the 64-byte cache line) and hold
+ * many keys each, so a lookup touches a few cache lines per level over a tree that is
+ * only log_B(n) levels deep, and a range scan walks the leaf chain sequentially.
+ *
+ * Searching inside a node counts the keys below the probe instead of branching on each
+ * comparison. With SSE2 (always available on x86-64), 32- and 64-bit integer keys are
+ * compared 16 bytes at a time with explicit intrinsics (SSE2 has no 64-bit compare, so
+ * 64-bit lanes use the sign of an overflow-corrected subtraction), stopping at the first
+ * block that is not entirely below the probe. Other arithmetic keys, and integer
+ * keys without SSE2, use a branch-free scalar loop over the whole fixed-size key array,
+ * which g++ 12 does not vectorize at -O2 or -O3 unless AVX2 is enabled (-mavx2). Other
+ * key types use binary search.
+ *
+ * Every node except the root is at least half full: an overflowing node splits in two,
+ * an underflowing one borrows a key from a sibling or merges with it. from_sorted()
+ * builds the tree bottom-up with full leaves.
+ *
+ * Keys are unique, like std::set, and must be default-constructible. Cursors are
+ * invalidated by insert, delete_node and clear.
+ *
+ * Time Complexity:
+ * - Insert: O(B log_B n)
+ * - Delete: O(B log_B n)
+ * - Search / Lower bound: O(B log_B n), 16 bytes of integer keys per SIMD compare
+ * - Range scan: O(log_B n + k) for k keys
+ * - Build from sorted input: O(n)
+ *
+ * Space Complexity: O(n)
+ */
+
+#ifndef B_PLUS_TREE_HPP
+#define B_PLUS_TREE_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace b_plus_tree_detail {
+
+#if defined(__SSE2__)
+// Keys the SSE2 node search handles: 32- or 64-bit integers, signed or unsigned
+template<typename T>
+inline constexpr bool sse2_key = std::is_integral_v<T> && (sizeof(T) == 4 || sizeof(T) == 8);
+
+template<typename T>
+inline __m128i broadcast(T value) {
+    if constexpr (sizeof(T) == 4) {
+        return _mm_set1_epi32(static_cast<int32_t>(value));
+    } else {
+        return _mm_set1_epi64x(static_cast<int64_t>(value));
+    }
+}
+
+// The sign bit of every lane is set where a > b (all-ones lanes for 32-bit keys)
+template<typename T>
+inline __m128i greater(__m128i a, __m128i b) {
+    if constexpr (std::is_unsigned_v<T>) {
+        // Flipping the sign bits makes the signed compare order unsigned values
+        const __m128i bias = sizeof(T) == 4 ? _mm_set1_epi32(INT32_MIN) : _mm_set1_epi64x(INT64_MIN);
+        a = _mm_xor_si128(a, bias);
+        b = _mm_xor_si128(b, bias);
+    }
+    if constexpr (sizeof(T) == 4) {
+        return _mm_cmpgt_epi32(a, b);
+    } else {
+        // SSE2 has no 64-bit compare: a > b is the sign of b - a, corrected on overflow
+        __m128i difference = _mm_sub_epi64(b, a);
+        __m128i overflow = _mm_and_si128(_mm_xor_si128(b, a), _mm_xor_si128(b, difference));
+        return _mm_xor_si128(difference, overflow);
+    }
+}
+
+// The sign bit of every lane
+template<typename T>
+inline unsigned lane_bits(__m128i mask) {
+    if constexpr (sizeof(T) == 4) {
+        return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(mask)));
+    } else {
+        return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(mask)));
+    }
+}
+#endif
+
+} // namespace b_plus_tree_detail
+
+template<typename T, size_t NodeBytes = 256>
+class BPlusTree {
+private:
+    static_assert(NodeBytes % 64 == 0, "Node size must be a multiple of the cache line");
+
+    static constexpr size_t HEADER_BYTES = 16;
+
+public:
+    static constexpr size_t LEAF_CAPACITY =
+        std::max<size_t>(4, (NodeBytes - HEADER_BYTES) / sizeof(T));
+    static constexpr size_t INNER_CAPACITY =
+        std::max<size_t>(4, (NodeBytes - HEADER_BYTES) / (sizeof(T) + sizeof(void*)));
+
+private:
+    static constexpr size_t LEAF_MIN = LEAF_CAPACITY / 2;
+    static constexpr size_t INNER_MIN = INNER_CAPACITY / 2;
+
+    struct alignas(64) Leaf {
+        uint32_t count = 0;
+        Leaf* next = nullptr;
+        T keys[LEAF_CAPACITY] = {};
+    };
+
+    // Child i holds the keys in [keys[i - 1], keys[i]); children are Leaf* one level above the leaves
+    struct alignas(64) Inner {
+        uint32_t count = 0;
+        void* children[INNER_CAPACITY + 1] = {};
+        T keys[INNER_CAPACITY] = {};
+    };
+
+    void* root;
+    size_t height;      // Inner levels above the leaves
+    size_t key_count;
+
+    // Number of keys in keys[0, count) less than data (or not greater than it, if Inclusive)
+    template<size_t Capacity, bool Inclusive>
+    static size_t count_below(const T (&keys)[Capacity], size_t count, const T& data) {
+        if constexpr (std::is_arithmetic_v<T>) {
+#if defined(__SSE2__)
+            if constexpr (b_plus_tree_detail::sse2_key<T>) {
+                using namespace b_plus_tree_detail;
+                constexpr size_t LANES = 16 / sizeof(T);
+                constexpr unsigned ALL_LANES = (1u << LANES) - 1;
+                __m128i probe = broadcast<T>(data);
+                // The keys are sorted, so the count ends in the first block not entirely below data
+                size_t below = 0;
+                size_t i = 0;
+                for (; i < count && i + LANES <= Capacity; i += LANES) {
+                    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+                    unsigned bits = Inclusive ? ~lane_bits<T>(greater<T>(block, probe)) & ALL_LANES
+                                              : lane_bits<T>(greater<T>(probe, block));
+                    if (count - i < LANES) {
+                        bits &= (1u << (count - i)) - 1;   // Lanes past count hold stale keys
+                    }
+                    below += static_cast<size_t>(__builtin_popcount(bits));
+                    if (bits != ALL_LANES) {
+                        return below;
+                    }
+                }
+                for (; i < count && (Inclusive ? !(data < keys[i]) : keys[i] < data); ++i) {
+                    below++;
+                }
+                return below;
+            }
+#endif
+            // Constant trip count and no branches
+            size_t below = 0;
+            for (size_t i = 0; i < Capacity; ++i) {
+                bool less = Inclusive ? !(data < keys[i]) : keys[i] < data;
+                below += static_cast<size_t>(less & (i < count));
+            }
+            return below;
+        } else if constexpr (Inclusive) {
+            return static_cast<size_t>(std::upper_bound(keys, keys + count, data) - keys);
+        } else {
+            return static_cast<size_t>(std::lower_bound(keys, keys + count, data) - keys);
+        }
+    }
+
+    static size_t node_count(void* node, size_t level) {
+        return level == 0 ? static_cast<Leaf*>(node)->count : static_cast<Inner*>(node)->count;
+    }
+
+    Leaf* find_leaf(const T& data) const {
+        void* node = root;
+        for (size_t level = height; level > 0; --level) {
+            Inner* inner = static_cast<Inner*>(node);
+            node = inner->children[count_below<INNER_CAPACITY, true>(inner->keys, inner->count, data)];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    static void insert_at(Leaf* leaf, size_t pos, const T& data) {
+        std::move_backward(leaf->keys + pos, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+        leaf->keys[pos] = data;
+        leaf->count++;
+    }
+
+    // Insert below node; on a split, returns the new right sibling and its separator
+    bool insert_recursive(void* node, size_t level, const T& data, T& split_key, void*& split_node) {
+        if (level == 0) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            size_t pos = count_below<LEAF_CAPACITY, false>(leaf->keys, leaf->count, data);
+            if (pos < leaf->count && !(data < leaf->keys[pos])) {
+                return false;
+            }
+            if (leaf->count < LEAF_CAPACITY) {
+                insert_at(leaf, pos, data);
+                return true;
+            }
+
+            Leaf* right = new Leaf();
+            size_t half = (LEAF_CAPACITY + 1) / 2;
+            std::move(leaf->keys + half, leaf->keys + leaf->count, right->keys);
+            right->count = static_cast<uint32_t>(leaf->count - half);
+            leaf->count = static_cast<uint32_t>(half);
+            right->next = leaf->next;
+            leaf->next = right;
+            if (pos >= half) {
+                insert_at(right, pos - half, data);
+            } else {
+                insert_at(leaf, pos, data);
+            }
+            split_key = right->keys[0];
+            split_node = right;
+            return true;
+        }
+
+        Inner* inner = static_cast<Inner*>(node);
+        size_t child = count_below<INNER_CAPACITY, true>(inner->keys, inner->count, data);
+        T child_key{};
+        void* child_node = nullptr;
+        if (!insert_recursive(inner->children[child], level - 1, data, child_key, child_node)) {
+            return false;
+        }
+        if (child_node == nullptr) {
+            return true;
+        }
+
+        if (inner->count < INNER_CAPACITY) {
+            std::move_backward(inner->keys + child, inner->keys + inner->count, inner->keys + inner->count + 1);
+            std::move_backward(inner->children + child + 1, inner->children + inner->count + 1,
+                               inner->children + inner->count + 2);
+            inner->keys[child] = child_key;
+            inner->children[child + 1] = child_node;
+            inner->count++;
+            return true;
+        }
+
+        // Full: lay out the CAPACITY + 1 keys in order, then give the upper half to a new node
+        T keys[INNER_CAPACITY + 1];
+        void* children[INNER_CAPACITY + 2];
+        std::move(inner->keys, inner->keys + child, keys);
+        keys[child] = child_key;
+        std::move(inner->keys + child, inner->keys + INNER_CAPACITY, keys + child + 1);
+        std::copy(inner->children, inner->children + child + 1, children);
+        children[child + 1] = child_node;
+        std::copy(inner->children + child + 1, inner->children + INNER_CAPACITY + 1, children + child + 2);
+
+        size_t total = INNER_CAPACITY + 1;
+        size_t middle = total / 2;
+        Inner* right = new Inner();
+        std::move(keys, keys + middle, inner->keys);
+        std::copy(children, children + middle + 1, inner->children);
+        inner->count = static_cast<uint32_t>(middle);
+        std::move(keys + middle + 1, keys + total, right->keys);
+        std::copy(children + middle + 1, children + total + 1, right->children);
+        right->count = static_cast<uint32_t>(total - middle - 1);
+        split_key = keys[middle];
+        split_node = right;
+        return true;
+    }
+
+    // Merge child index + 1 of parent into child index, dropping their separator
+    void merge_children(Inner* parent, size_t index, size_t child_level) {
+        if (child_level == 0) {
+            Leaf* left = static_cast<Leaf*>(parent->children[index]);
+            Leaf* right = static_cast<Leaf*>(parent->children[index + 1]);
+            std::move(right->keys, right->keys + right->count, left->keys + left->count);
+            left->count += right->count;
+            left->next = right->next;
+            delete right;
+        } else {
+            Inner* left = static_cast<Inner*>(parent->children[index]);
+            Inner* right = static_cast<Inner*>(parent->children[index + 1]);
+            left->keys[left->count] = parent->keys[index];
+            std::move(right->keys, right->keys + right->count, left->keys + left->count + 1);
+            std::copy(right->children, right->children + right->count + 1, left->children + left->count + 1);
+            left->count += right->count + 1;
+            delete right;
+        }
+        std::move(parent->keys + index + 1, parent->keys + parent->count, parent->keys + index);
+        std::copy(parent->children + index + 2, parent->children + parent->count + 1, parent->children + index + 1);
+        parent->count--;
+    }
+
+    // Restore the minimum fill of child index of parent by borrowing from or merging with a sibling
+    void rebalance(Inner* parent, size_t index, size_t child_level) {
+        size_t minimum = child_level == 0 ? LEAF_MIN : INNER_MIN;
+        void* child = parent->children[index];
+        void* left = index > 0 ? parent->children[index - 1] : nullptr;
+        void* right = index < parent->count ? parent->children[index + 1] : nullptr;
+
+        if (left && node_count(left, child_level) > minimum) {
+            if (child_level == 0) {
+                Leaf* to = static_cast<Leaf*>(child);
+                Leaf* from = static_cast<Leaf*>(left);
+                insert_at(to, 0, from->keys[from->count - 1]);
+                from->count--;
+                parent->keys[index - 1] = to->keys[0];
+            } else {
+                Inner* to = static_cast<Inner*>(child);
+                Inner* from = static_cast<Inner*>(left);
+                std::move_backward(to->keys, to->keys + to->count, to->keys + to->count + 1);
+                std::copy_backward(to->children, to->children + to->count + 1, to->children + to->count + 2);
+                to->keys[0] = parent->keys[index - 1];
+                to->children[0] = from->children[from->count];
+                to->count++;
+                parent->keys[index - 1] = from->keys[from->count - 1];
+                from->count--;
+            }
+            return;
+        }
+
+        if (right && node_count(right, child_level) > minimum) {
+            if (child_level == 0) {
+                Leaf* to = static_cast<Leaf*>(child);
+                Leaf* from = static_cast<Leaf*>(right);
+                to->keys[to->count++] = from->keys[0];
+                std::move(from->keys + 1, from->keys + from->count, from->keys);
+                from->count--;
+                parent->keys[index] = from->keys[0];
+            } else {
+                Inner* to = static_cast<Inner*>(child);
+                Inner* from = static_cast<Inner*>(right);
+                to->keys[to->count] = parent->keys[index];
+                to->children[to->count + 1] = from->children[0];
+                to->count++;
+                parent->keys[index] = from->keys[0];
+                std::move(from->keys + 1, from->keys + from->count, from->keys);
+                std::copy(from->children + 1, from->children + from->count + 1, from->children);
+                from->count--;
+            }
+            return;
+        }
+
+        merge_children(parent, left ? index - 1 : index, child_level);
+    }
+
+    bool delete_recursive(void* node, size_t level, const T& data) {
+        if (level == 0) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            size_t pos = count_below<LEAF_CAPACITY, false>(leaf->keys, leaf->count, data);
+            if (pos == leaf->count || data < leaf->keys[pos]) {
+                return false;
+            }
+            std::move(leaf->keys + pos + 1, leaf->keys + leaf->count, leaf->keys + pos);
+            leaf->count--;
+            return true;
+        }
+
+        // Separators may keep a deleted key; they still route correctly
+        Inner* inner = static_cast<Inner*>(node);
+        size_t child = count_below<INNER_CAPACITY, true>(inner->keys, inner->count, data);
+        if (!delete_recursive(inner->children[child], level - 1, data)) {
+            return false;
+        }
+        if (node_count(inner->children[child], level - 1) < (level == 1 ? LEAF_MIN : INNER_MIN)) {
+            rebalance(inner, child, level - 1);
+        }
+        return true;
+    }
+
+    static void clear_recursive(void* node, size_t level) {
+        if (node == nullptr) {
+            return;
+        }
+        if (level == 0) {
+            delete static_cast<Leaf*>(node);
+            return;
+        }
+        Inner* inner = static_cast<Inner*>(node);
+        for (size_t i = 0; i <= inner->count; ++i) {
+            clear_recursive(inner->children[i], level - 1);
+        }
+        delete inner;
+    }
+
+    // Sizes of `parts` nearly equal groups covering `total` items
+    static size_t group_begin(size_t total, size_t parts, size_t group) {
+        return total / parts * group + std::min(group, total % parts);
+    }
+
+public:
+    /**
+     * @class const_iterator
+     * @brief Forward cursor over the keys in ascending order, following the leaf chain
+     */
+    class const_iterator {
+    private:
+        const Leaf* leaf;
+        size_t index;
+
+        friend class BPlusTree;
+
+        const_iterator(const Leaf* leaf, size_t index) : leaf(leaf), index(index) {
+            if (this->leaf && this->index == this->leaf->count) {
+                this->leaf = this->leaf->next;
+                this->index = 0;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() : leaf(nullptr), index(0) {}
+
+        const T& operator*() const {
+            return leaf->keys[index];
+        }
+
+        const T* operator->() const {
+            return &leaf->keys[index];
+        }
+
+        const_iterator& operator++() {
+            if (++index == leaf->count) {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return leaf == other.leaf && index == other.index;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * @brief Default constructor
+     */
+    BPlusTree() : root(nullptr), height(0), key_count(0) {}
+
+    /**
+     * @brief Copy constructor (rebuilds the copy with full leaves)
+     * @param other The B+ tree to copy
+     */
+    BPlusTree(const BPlusTree& other) : BPlusTree() {
+        *this = from_sorted(other.inorder_traversal());
+    }
+
+    /**
+     * @brief Move constructor
+     * @param other The B+ tree to take the nodes from; left empty
+     */
+    BPlusTree(BPlusTree&& other) noexcept : root(other.root), height(other.height), key_count(other.key_count) {
+        other.root = nullptr;
+        other.height = 0;
+        other.key_count = 0;
+    }
+
+    /**
+     * @brief Copy or move assignment
+     * @param other The B+ tree to take the contents of
+     * @return This B+ tree
+     */
+    BPlusTree& operator=(BPlusTree other) noexcept {
+        std::swap(root, other.root);
+        std::swap(height, other.height);
+        std::swap(key_count, other.key_count);
+        return *this;
+    }
+
+    /**
+     * @brief Destructor
+     */
+    ~BPlusTree() {
+        clear();
+    }
+
+    /**
+     * @brief Build a B+ tree from sorted keys in O(n), with full leaves
+     * @param sorted Keys in strictly increasing order
+     * @return The B+ tree holding the keys
+     * @throw std::invalid_argument if the keys are not strictly increasing
+     */
+    static BPlusTree from_sorted(const std::vector<T>& sorted) {
+        if (std::adjacent_find(sorted.begin(), sorted.end(), [](const T& a, const T& b) {
+                return !(a < b);
+            }) != sorted.end()) {
+            throw std::invalid_argument("Keys must be strictly increasing");
+        }
+
+        BPlusTree tree;
+        if (sorted.empty()) {
+            return tree;
+        }
+
+        // Spread the items of each level evenly over the fewest nodes that can hold them,
+        // which leaves every node at least half full
+        size_t n = sorted.size();
+        size_t leaves = (n + LEAF_CAPACITY - 1) / LEAF_CAPACITY;
+        std::vector<void*> level(leaves);
+        std::vector<T> first_keys(leaves);
+        Leaf* previous = nullptr;
+        for (size_t i = 0; i < leaves; ++i) {
+            size_t begin = group_begin(n, leaves, i);
+            size_t end = group_begin(n, leaves, i + 1);
+            Leaf* leaf = new Leaf();
+            std::copy(sorted.begin() + static_cast<std::ptrdiff_t>(begin),
+                      sorted.begin() + static_cast<std::ptrdiff_t>(end), leaf->keys);
+            leaf->count = static_cast<uint32_t>(end - begin);
+            if (previous) {
+                previous->next = leaf;
+            }
+            previous = leaf;
+            level[i] = leaf;
+            first_keys[i] = sorted[begin];
+        }
+
+        size_t height = 0;
+        while (level.size() > 1) {
+            size_t m = level.size();
+            size_t parents = (m + INNER_CAPACITY) / (INNER_CAPACITY + 1);
+            std::vector<void*> upper(parents);
+            std::vector<T> upper_keys(parents);
+            for (size_t p = 0; p < parents; ++p) {
+                size_t begin = group_begin(m, parents, p);
+                size_t end = group_begin(m, parents, p + 1);
+                Inner* inner = new Inner();
+                for (size_t c = begin; c < end; ++c) {
+                    inner->children[c - begin] = level[c];
+                    if (c > begin) {
+                        inner->keys[c - begin - 1] = first_keys[c];
+                    }
+                }
+                inner->count = static_cast<uint32_t>(end - begin - 1);
+                upper[p] = inner;
+                upper_keys[p] = first_keys[begin];
+            }
+            level = std::move(upper);
+            first_keys = std::move(upper_keys);
+            height++;
+        }
+
+        tree.root = level[0];
+        tree.height = height;
+        tree.key_count = n;
+        return tree;
+    }
+
+    /**
+     * @brief Check if the B+ tree is empty
+     * @return true if the B+ tree is empty, false otherwise
+     */
+    bool is_empty() const {
+        return root == nullptr;
+    }
+
+    /**
+     * @brief Get the number of keys in the B+ tree
+     */
+    size_t size() const {
+        return key_count;
+    }
+
+    /**
+     * @brief Insert a key into the B+ tree
+     * @param data The key to be inserted
+     * @return true if the key was inserted, false if it was already present
+     */
+    bool insert(const T& data) {
+        if (root == nullptr) {
+            root = new Leaf();
+            height = 0;
+        }
+
+        T split_key{};
+        void* split_node = nullptr;
+        if (!insert_recursive(root, height, data, split_key, split_node)) {
+            return false;
+        }
+        if (split_node) {
+            Inner* top = new Inner();
+            top->count = 1;
+            top->keys[0] = split_key;
+            top->children[0] = root;
+            top->children[1] = split_node;
+            root = top;
+            height++;
+        }
+        key_count++;
+        return true;
+    }
+
+    /**
+     * @brief Delete a key from the B+ tree
+     * @param data The key to be deleted
+     * @return true if the key was deleted, false if it was not present
+     */
+    bool delete_node(const T& data) {
+        if (is_empty() || !delete_recursive(root, height, data)) {
+            return false;
+        }
+
+        key_count--;
+        if (height > 0 && static_cast<Inner*>(root)->count == 0) {
+            Inner* old = static_cast<Inner*>(root);
+            root = old->children[0];
+            height--;
+            delete old;
+        } else if (height == 0 && static_cast<Leaf*>(root)->count == 0) {
+            delete static_cast<Leaf*>(root);
+            root = nullptr;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Search for a key in the B+ tree
+     * @param data The key to search for
+     * @return true if the key is found, false otherwise
+     */
+    bool search(const T& data) const {
+        if (is_empty()) {
+            return false;
+        }
+
+        Leaf* leaf = find_leaf(data);
+        size_t pos = count_below<LEAF_CAPACITY, false>(leaf->keys, leaf->count, data);
+        return pos < leaf->count && !(data < leaf->keys[pos]);
+    }
+
+    /**
+     * @brief Get a cursor at the smallest key
+     */
+    const_iterator begin() const {
+        if (is_empty()) {
+            return end();
+        }
+
+        void* node = root;
+        for (size_t level = height; level > 0; --level) {
+            node = static_cast<Inner*>(node)->children[0];
+        }
+        return const_iterator(static_cast<Leaf*>(node), 0);
+    }
+
+    /**
+     * @brief Get the past-the-end cursor
+     */
+    const_iterator end() const {
+        return const_iterator();
+    }
+
+    /**
+     * @brief Get a cursor at the first key not less than a value
+     * @param data The value
+     * @return The cursor, or end() if every key is less than data
+     */
+    const_iterator lower_bound(const T& data) const {
+        if (is_empty()) {
+            return end();
+        }
+
+        Leaf* leaf = find_leaf(data);
+        return const_iterator(leaf, count_below<LEAF_CAPACITY, false>(leaf->keys, leaf->count, data));
+    }
+
+    /**
+     * @brief Get a cursor at the first key greater than a value
+     * @param data The value
+     * @return The cursor, or end() if no key is greater than data
+     */
+    const_iterator upper_bound(const T& data) const {
+        if (is_empty()) {
+            return end();
+        }
+
+        Leaf* leaf = find_leaf(data);
+        return const_iterator(leaf, count_below<LEAF_CAPACITY, true>(leaf->keys, leaf->count, data));
+    }
+
+    /**
+     * @brief Collect the keys in the closed range [low, high]
+     * @param low The lower bound
+     * @param high The upper bound
+     * @return The keys in ascending order
+     */
+    std::vector<T> range(const T& low, const T& high) const {
+        std::vector<T> result;
+        for (auto it = lower_bound(low); it != end() && !(high < *it); ++it) {
+            result.push_back(*it);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Get all keys in ascending order
+     * @return A vector containing the keys in sorted order
+     */
+    std::vector<T> inorder_traversal() const {
+        std::vector<T> result;
+        result.reserve(key_count);
+        for (auto it = begin(); it != end(); ++it) {
+            result.push_back(*it);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Get the minimum key in the B+ tree
+     * @return The minimum key
+     * @throw std::runtime_error if the B+ tree is empty
+     */
+    T get_min() const {
+        if (is_empty()) {
+            throw std::runtime_error("B+ tree is empty");
+        }
+
+        return *begin();
+    }
+
+    /**
+     * @brief Get the maximum key in the B+ tree
+     * @return The maximum key
+     * @throw std::runtime_error if the B+ tree is empty
+     */
+    T get_max() const {
+        if (is_empty()) {
+            throw std::runtime_error("B+ tree is empty");
+        }
+
+        void* node = root;
+        for (size_t level = height; level > 0; --level) {
+            Inner* inner = static_cast<Inner*>(node);
+            node = inner->children[inner->count];
+        }
+        Leaf* leaf = static_cast<Leaf*>(node);
+        return leaf->keys[leaf->count - 1];
+    }
+
+    /**
+     * @brief Remove all keys from the B+ tree
+     */
+    void clear() {
+        clear_recursive(root, height);
+        root = nullptr;
+        height = 0;
+        key_count = 0;
+    }
+};
+
+#endif // B_PLUS_TREE_HPP
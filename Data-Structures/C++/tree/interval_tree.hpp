@@ -0,0 +1,552 @@
+/**
+ * @file interval_tree.hpp
+ * @brief Interval trees: a dynamic AVL-based tree and a static batch-built tree
+ *
+ * IntervalTree is an AVL tree of closed intervals [low, high] ordered by (low, high),
+ * built on the shared nodes, rotations and rebalancing of avl_tree.hpp. Its augmentation
+ * policy (IntervalMaxHigh) makes every node also store the largest high endpoint in its
+ * subtree, refreshed together with the height and size on every rotation. An overlap
+ * query skips any subtree whose largest endpoint is below the query, and any right
+ * subtree whose smallest low is above it, so it reports the k hits in sorted order
+ * while visiting O(min(n, (k + 1) log n)) nodes.
+ *
+ * StaticIntervalTree is built once from a batch of intervals and is read-only. It is a
+ * centered interval tree stored in flat arrays: every node keeps the intervals that
+ * contain its center point twice, sorted by low and by high, so a stabbing query scans
+ * each list only as far as it finds hits. An overlap query for [a, b] is a stabbing
+ * query at a plus a binary-searched run of the intervals with a < low <= b in one array
+ * sorted by low. Both queries take O(log n + k).
+ *
+ * Time Complexity:
+ * - IntervalTree insert / delete / search: O(log n)
+ * - IntervalTree stabbing / overlap query: O(min(n, (k + 1) log n)) for k hits
+ * - StaticIntervalTree build: O(n log n)
+ * - StaticIntervalTree stabbing / overlap query: O(log n + k)
+ *
+ * Space Complexity: O(n)
+ */
+
+#ifndef INTERVAL_TREE_HPP
+#define INTERVAL_TREE_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+
+#include "avl_tree.hpp"
+
+/**
+ * @brief A closed interval [low, high]
+ */
+template<typename T>
+struct Interval {
+    T low;
+    T high;
+
+    bool operator==(const Interval& other) const {
+        return !(low < other.low) && !(other.low < low) && !(high < other.high) && !(other.high < high);
+    }
+
+    // Ordered by low, then by high
+    bool operator<(const Interval& other) const {
+        return low < other.low || (!(other.low < low) && high < other.high);
+    }
+
+    /**
+     * @brief Check if the interval shares at least one point with [low, high]
+     */
+    bool overlaps(const T& other_low, const T& other_high) const {
+        return !(other_high < low) && !(high < other_low);
+    }
+};
+
+/**
+ * @brief AVL augmentation policy: the largest high endpoint in each subtree
+ */
+template<typename T>
+struct IntervalMaxHigh {
+    T max_high;     // Largest high endpoint in this subtree
+
+    template<typename N>
+    static void update(N* node) {
+        node->max_high = node->data.high;
+        if (node->left && node->max_high < node->left->max_high) {
+            node->max_high = node->left->max_high;
+        }
+        if (node->right && node->max_high < node->right->max_high) {
+            node->max_high = node->right->max_high;
+        }
+    }
+};
+
+template<typename T>
+using IntervalNode = Node<Interval<T>, IntervalMaxHigh<T>>;
+
+/**
+ * @class IntervalTree
+ * @brief Dynamic interval tree: an AVL tree of intervals augmented with subtree max endpoints
+ */
+template<typename T>
+class IntervalTree {
+private:
+    using Node = IntervalNode<T>;
+
+    Node* root;
+
+    Node* insert_recursive(Node* node, const Interval<T>& interval) {
+        if (node == nullptr) {
+            return new Node(interval);
+        }
+
+        if (interval < node->data) {
+            node->left = insert_recursive(node->left, interval);
+        } else {
+            node->right = insert_recursive(node->right, interval);
+        }
+
+        return avl_detail::rebalance(node);
+    }
+
+    Node* delete_recursive(Node* node, const Interval<T>& interval, bool& deleted) {
+        if (node == nullptr) {
+            return nullptr;
+        }
+
+        if (interval < node->data) {
+            node->left = delete_recursive(node->left, interval, deleted);
+        } else if (node->data < interval) {
+            node->right = delete_recursive(node->right, interval, deleted);
+        } else {
+            deleted = true;
+            if (node->left == nullptr) {
+                Node* temp = node->right;
+                delete node;
+                return temp;
+            } else if (node->right == nullptr) {
+                Node* temp = node->left;
+                delete node;
+                return temp;
+            }
+
+            // Node with two children: Get the inorder successor
+            Node* temp = node->right;
+            while (temp->left) {
+                temp = temp->left;
+            }
+
+            node->data = temp->data;
+            bool removed = false;
+            node->right = delete_recursive(node->right, temp->data, removed);
+        }
+
+        return avl_detail::rebalance(node);
+    }
+
+    template<typename Visitor>
+    void overlap_recursive(Node* node, const T& low, const T& high, Visitor& visitor) const {
+        if (node == nullptr || node->max_high < low) {
+            return;
+        }
+
+        overlap_recursive(node->left, low, high, visitor);
+        if (high < node->data.low) {
+            return;
+        }
+        if (!(node->data.high < low)) {
+            visitor(node->data);
+        }
+        overlap_recursive(node->right, low, high, visitor);
+    }
+
+    Node* copy_recursive(Node* node) const {
+        if (node == nullptr) {
+            return nullptr;
+        }
+        Node* copy = new Node(*node);
+        copy->left = copy_recursive(node->left);
+        copy->right = copy_recursive(node->right);
+        return copy;
+    }
+
+    void clear_recursive(Node* node) {
+        if (node) {
+            clear_recursive(node->left);
+            clear_recursive(node->right);
+            delete node;
+        }
+    }
+
+public:
+    /**
+     * @brief Default constructor
+     */
+    IntervalTree() : root(nullptr) {}
+
+    /**
+     * @brief Copy constructor (deep copy)
+     * @param other The interval tree to copy
+     */
+    IntervalTree(const IntervalTree& other) : root(copy_recursive(other.root)) {}
+
+    /**
+     * @brief Move constructor
+     * @param other The interval tree to take the nodes from; left empty
+     */
+    IntervalTree(IntervalTree&& other) noexcept : root(other.root) {
+        other.root = nullptr;
+    }
+
+    /**
+     * @brief Copy or move assignment
+     * @param other The interval tree to take the contents of
+     * @return This interval tree
+     */
+    IntervalTree& operator=(IntervalTree other) noexcept {
+        std::swap(root, other.root);
+        return *this;
+    }
+
+    /**
+     * @brief Destructor
+     */
+    ~IntervalTree() {
+        clear();
+    }
+
+    /**
+     * @brief Check if the interval tree is empty
+     * @return true if the interval tree is empty, false otherwise
+     */
+    bool is_empty() const {
+        return root == nullptr;
+    }
+
+    /**
+     * @brief Get the number of stored intervals
+     * @return The number of intervals, counting duplicates
+     */
+    size_t size() const {
+        return avl_detail::size(root);
+    }
+
+    /**
+     * @brief Insert an interval (duplicates are kept)
+     * @param low The lower endpoint
+     * @param high The upper endpoint (inclusive)
+     * @throw std::invalid_argument if high < low
+     */
+    void insert(const T& low, const T& high) {
+        if (high < low) {
+            throw std::invalid_argument("Interval upper endpoint is below its lower endpoint");
+        }
+
+        root = insert_recursive(root, Interval<T>{low, high});
+    }
+
+    /**
+     * @brief Delete one occurrence of an interval
+     * @param low The lower endpoint
+     * @param high The upper endpoint
+     * @return true if the interval was deleted, false if it was not present
+     */
+    bool delete_node(const T& low, const T& high) {
+        bool deleted = false;
+        root = delete_recursive(root, Interval<T>{low, high}, deleted);
+        return deleted;
+    }
+
+    /**
+     * @brief Search for an interval with exactly the given endpoints
+     * @param low The lower endpoint
+     * @param high The upper endpoint
+     * @return true if the interval is stored, false otherwise
+     */
+    bool search(const T& low, const T& high) const {
+        Interval<T> interval{low, high};
+        Node* current = root;
+        while (current) {
+            if (interval < current->data) {
+                current = current->left;
+            } else if (current->data < interval) {
+                current = current->right;
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Visit every stored interval that overlaps [low, high], in (low, high) order
+     * @param low The lower endpoint of the query
+     * @param high The upper endpoint of the query
+     * @param visitor Called as visitor(interval) once per hit
+     */
+    template<typename Visitor>
+    void for_each_overlap(const T& low, const T& high, Visitor visitor) const {
+        if (!(high < low)) {
+            overlap_recursive(root, low, high, visitor);
+        }
+    }
+
+    /**
+     * @brief Find every stored interval that overlaps [low, high]
+     * @param low The lower endpoint of the query
+     * @param high The upper endpoint of the query
+     * @return The overlapping intervals in (low, high) order
+     */
+    std::vector<Interval<T>> overlapping(const T& low, const T& high) const {
+        std::vector<Interval<T>> result;
+        for_each_overlap(low, high, [&](const Interval<T>& interval) {
+            result.push_back(interval);
+        });
+        return result;
+    }
+
+    /**
+     * @brief Find every stored interval that contains a point
+     * @param point The point
+     * @return The intervals containing point, in (low, high) order
+     */
+    std::vector<Interval<T>> stabbing(const T& point) const {
+        return overlapping(point, point);
+    }
+
+    /**
+     * @brief Get the largest high endpoint of all stored intervals
+     * @return The largest high endpoint
+     * @throw std::runtime_error if the interval tree is empty
+     */
+    T get_max_endpoint() const {
+        if (is_empty()) {
+            throw std::runtime_error("Interval tree is empty");
+        }
+
+        return root->max_high;
+    }
+
+    /**
+     * @brief Perform an inorder traversal of the interval tree
+     * @return A vector containing the intervals in (low, high) order
+     */
+    std::vector<Interval<T>> inorder_traversal() const {
+        std::vector<Interval<T>> result;
+        result.reserve(size());
+
+        std::function<void(Node*)> inorder = [&](Node* node) {
+            if (node) {
+                inorder(node->left);
+                result.push_back(node->data);
+                inorder(node->right);
+            }
+        };
+
+        inorder(root);
+        return result;
+    }
+
+    /**
+     * @brief Remove all intervals from the interval tree
+     */
+    void clear() {
+        clear_recursive(root);
+        root = nullptr;
+    }
+};
+
+/**
+ * @class StaticIntervalTree
+ * @brief Read-only centered interval tree in flat arrays, built from a batch
+ */
+template<typename T>
+class StaticIntervalTree {
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    // The intervals containing center are by_low[begin, end) and by_high[begin, end)
+    struct CenterNode {
+        T center;
+        uint32_t begin;
+        uint32_t end;
+        uint32_t left;
+        uint32_t right;
+    };
+
+    std::vector<CenterNode> nodes;          // Preorder; nodes[0] is the root
+    std::vector<Interval<T>> by_low;        // Per node, sorted by low ascending
+    std::vector<Interval<T>> by_high;       // Per node, sorted by high descending
+    std::vector<Interval<T>> sorted;        // All intervals in (low, high) order
+
+    uint32_t build(std::vector<Interval<T>>& intervals) {
+        if (intervals.empty()) {
+            return NONE;
+        }
+
+        // The median endpoint leaves at most half of the intervals on either side
+        std::vector<T> endpoints;
+        endpoints.reserve(intervals.size() * 2);
+        for (const Interval<T>& interval : intervals) {
+            endpoints.push_back(interval.low);
+            endpoints.push_back(interval.high);
+        }
+        auto median = endpoints.begin() + static_cast<std::ptrdiff_t>(intervals.size());
+        std::nth_element(endpoints.begin(), median, endpoints.end());
+        T center = *median;
+
+        std::vector<Interval<T>> left, right;
+        uint32_t begin = static_cast<uint32_t>(by_low.size());
+        for (const Interval<T>& interval : intervals) {
+            if (interval.high < center) {
+                left.push_back(interval);
+            } else if (center < interval.low) {
+                right.push_back(interval);
+            } else {
+                by_low.push_back(interval);
+                by_high.push_back(interval);
+            }
+        }
+        uint32_t end = static_cast<uint32_t>(by_low.size());
+        std::sort(by_low.begin() + begin, by_low.end(), [](const Interval<T>& a, const Interval<T>& b) {
+            return a.low < b.low;
+        });
+        std::sort(by_high.begin() + begin, by_high.end(), [](const Interval<T>& a, const Interval<T>& b) {
+            return b.high < a.high;
+        });
+
+        std::vector<Interval<T>>().swap(intervals);
+        uint32_t index = static_cast<uint32_t>(nodes.size());
+        nodes.push_back({center, begin, end, NONE, NONE});
+        uint32_t left_index = build(left);
+        uint32_t right_index = build(right);
+        nodes[index].left = left_index;
+        nodes[index].right = right_index;
+        return index;
+    }
+
+public:
+    /**
+     * @brief Default constructor (empty tree)
+     */
+    StaticIntervalTree() = default;
+
+    /**
+     * @brief Build the tree from a batch of intervals
+     * @param intervals The intervals (duplicates are kept)
+     * @throw std::invalid_argument if an interval has high < low
+     */
+    explicit StaticIntervalTree(std::vector<Interval<T>> intervals) {
+        for (const Interval<T>& interval : intervals) {
+            if (interval.high < interval.low) {
+                throw std::invalid_argument("Interval upper endpoint is below its lower endpoint");
+            }
+        }
+
+        sorted = intervals;
+        std::sort(sorted.begin(), sorted.end());
+        by_low.reserve(intervals.size());
+        by_high.reserve(intervals.size());
+        build(intervals);
+    }
+
+    /**
+     * @brief Check if the tree is empty
+     * @return true if the tree holds no intervals, false otherwise
+     */
+    bool is_empty() const {
+        return sorted.empty();
+    }
+
+    /**
+     * @brief Get the number of stored intervals
+     */
+    size_t size() const {
+        return sorted.size();
+    }
+
+    /**
+     * @brief Visit every stored interval that contains a point
+     * @param point The point
+     * @param visitor Called as visitor(interval) once per hit, in no particular order
+     */
+    template<typename Visitor>
+    void for_each_stabbing(const T& point, Visitor visitor) const {
+        uint32_t index = nodes.empty() ? NONE : 0;
+        while (index != NONE) {
+            const CenterNode& node = nodes[index];
+            if (point < node.center) {
+                // Every interval here ends at or after center > point; it hits iff low <= point
+                for (uint32_t i = node.begin; i < node.end && !(point < by_low[i].low); ++i) {
+                    visitor(by_low[i]);
+                }
+                index = node.left;
+            } else if (node.center < point) {
+                for (uint32_t i = node.begin; i < node.end && !(by_high[i].high < point); ++i) {
+                    visitor(by_high[i]);
+                }
+                index = node.right;
+            } else {
+                for (uint32_t i = node.begin; i < node.end; ++i) {
+                    visitor(by_low[i]);
+                }
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Visit every stored interval that overlaps [low, high]
+     * @param low The lower endpoint of the query
+     * @param high The upper endpoint of the query
+     * @param visitor Called as visitor(interval) once per hit, in no particular order
+     */
+    template<typename Visitor>
+    void for_each_overlap(const T& low, const T& high, Visitor visitor) const {
+        if (high < low) {
+            return;
+        }
+
+        // Hits either contain low, or start inside (low, high]
+        for_each_stabbing(low, visitor);
+        auto first = std::upper_bound(sorted.begin(), sorted.end(), low, [](const T& value, const Interval<T>& interval) {
+            return value < interval.low;
+        });
+        for (auto it = first; it != sorted.end() && !(high < it->low); ++it) {
+            visitor(*it);
+        }
+    }
+
+    /**
+     * @brief Find every stored interval that contains a point
+     * @param point The point
+     * @return The intervals containing point, in (low, high) order
+     */
+    std::vector<Interval<T>> stabbing(const T& point) const {
+        std::vector<Interval<T>> result;
+        for_each_stabbing(point, [&](const Interval<T>& interval) {
+            result.push_back(interval);
+        });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    /**
+     * @brief Find every stored interval that overlaps [low, high]
+     * @param low The lower endpoint of the query
+     * @param high The upper endpoint of the query
+     * @return The overlapping intervals in (low, high) order
+     */
+    std::vector<Interval<T>> overlapping(const T& low, const T& high) const {
+        std::vector<Interval<T>> result;
+        for_each_overlap(low, high, [&](const Interval<T>& interval) {
+            result.push_back(interval);
+        });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+};
+
+#endif // INTERVAL_TREE_HPP
@@ -0,0 +1,422 @@
+/**
+ * @file persistent_avl_tree.hpp
+ * @brief Persistent (path-copying) AVL tree with O(1) snapshots and lock-free readers
+ *
+ * Nodes are immutable once built and are shared between versions through reference
+ * counting. An insert or delete copies only the nodes on the root-to-leaf path it
+ * touches (plus the O(1) nodes that rotations rebuild) and links them to the untouched
+ * subtrees of the previous version. The new root is then published with one atomic
+ * pointer store.
+ *
+ * snapshot() atomically loads the current root. The snapshot is an immutable tree that
+ * any number of threads can read without locks while the writer keeps publishing new
+ * versions. A node is freed when the last version referencing it goes away. Writers are
+ * serialized by a mutex; readers never take it.
+ *
+ * Like AVLTree, the tree keeps duplicates (inserted to the right of equal keys) and
+ * stores subtree sizes for order-statistic queries.
+ *
+ * Time Complexity:
+ * - Insert: O(log n) time, O(log n) new nodes
+ * - Delete: O(log n) time, O(log n) new nodes
+ * - Snapshot: O(1)
+ * - Search / Rank / Select / Range count: O(log n)
+ * - Traversal: O(n)
+ *
+ * Space Complexity: O(n) for the latest version, plus O(log n) per update still visible
+ * through a live snapshot
+ */
+
+#ifndef PERSISTENT_AVL_TREE_HPP
+#define PERSISTENT_AVL_TREE_HPP
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+
+template<typename T>
+class PersistentAVLNode {
+public:
+    using Ptr = std::shared_ptr<const PersistentAVLNode>;
+
+    T data;
+    Ptr left;
+    Ptr right;
+    int height;
+    size_t size;
+
+    PersistentAVLNode(const T& data, Ptr left, Ptr right)
+        : data(data), left(std::move(left)), right(std::move(right)), height(1), size(1) {
+        int left_height = this->left ? this->left->height : 0;
+        int right_height = this->right ? this->right->height : 0;
+        height = std::max(left_height, right_height) + 1;
+        size = (this->left ? this->left->size : 0) + (this->right ? this->right->size : 0) + 1;
+    }
+};
+
+/**
+ * @class PersistentAVLSnapshot
+ * @brief An immutable version of a PersistentAVLTree; safe to read from any number of threads
+ */
+template<typename T>
+class PersistentAVLSnapshot {
+private:
+    using NodePtr = typename PersistentAVLNode<T>::Ptr;
+
+    NodePtr root;
+
+    // Number of keys less than data (or not greater than it, if inclusive)
+    size_t count_below(const T& data, bool inclusive) const {
+        size_t count = 0;
+        const PersistentAVLNode<T>* current = root.get();
+        while (current) {
+            bool go_right = inclusive ? !(data < current->data) : current->data < data;
+            if (go_right) {
+                count += (current->left ? current->left->size : 0) + 1;
+                current = current->right.get();
+            } else {
+                current = current->left.get();
+            }
+        }
+        return count;
+    }
+
+public:
+    /**
+     * @brief Create a snapshot of the tree rooted at the given node
+     * @param root The root, or nullptr for an empty tree
+     */
+    explicit PersistentAVLSnapshot(NodePtr root = nullptr) : root(std::move(root)) {}
+
+    /**
+     * @brief Check if the snapshot is empty
+     * @return true if the snapshot holds no keys, false otherwise
+     */
+    bool is_empty() const {
+        return root == nullptr;
+    }
+
+    /**
+     * @brief Get the number of keys in the snapshot
+     * @return The number of keys, counting duplicates
+     */
+    size_t size() const {
+        return root ? root->size : 0;
+    }
+
+    /**
+     * @brief Search for a key
+     * @param data The key to search for
+     * @return true if the key is present, false otherwise
+     */
+    bool search(const T& data) const {
+        const PersistentAVLNode<T>* current = root.get();
+        while (current) {
+            if (data < current->data) {
+                current = current->left.get();
+            } else if (current->data < data) {
+                current = current->right.get();
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Get the rank of a value
+     * @param data The value (need not be in the snapshot)
+     * @return The number of keys strictly less than data
+     */
+    size_t rank(const T& data) const {
+        return count_below(data, false);
+    }
+
+    /**
+     * @brief Get the k-th smallest key
+     * @param k The zero-based position in sorted order
+     * @return The key with exactly k keys before it in sorted order
+     * @throw std::out_of_range if k >= size()
+     */
+    T select(size_t k) const {
+        if (k >= size()) {
+            throw std::out_of_range("Rank is out of range");
+        }
+
+        const PersistentAVLNode<T>* current = root.get();
+        while (true) {
+            size_t left_size = current->left ? current->left->size : 0;
+            if (k < left_size) {
+                current = current->left.get();
+            } else if (k == left_size) {
+                return current->data;
+            } else {
+                k -= left_size + 1;
+                current = current->right.get();
+            }
+        }
+    }
+
+    /**
+     * @brief Count the keys in the closed range [low, high]
+     * @param low The lower bound
+     * @param high The upper bound
+     * @return The number of keys k with low <= k <= high (0 if low > high)
+     */
+    size_t count_range(const T& low, const T& high) const {
+        if (high < low) {
+            return 0;
+        }
+        return count_below(high, true) - count_below(low, false);
+    }
+
+    /**
+     * @brief Get the minimum key
+     * @return The minimum key
+     * @throw std::runtime_error if the snapshot is empty
+     */
+    T get_min() const {
+        if (is_empty()) {
+            throw std::runtime_error("AVL tree is empty");
+        }
+
+        const PersistentAVLNode<T>* current = root.get();
+        while (current->left) {
+            current = current->left.get();
+        }
+        return current->data;
+    }
+
+    /**
+     * @brief Get the maximum key
+     * @return The maximum key
+     * @throw std::runtime_error if the snapshot is empty
+     */
+    T get_max() const {
+        if (is_empty()) {
+            throw std::runtime_error("AVL tree is empty");
+        }
+
+        const PersistentAVLNode<T>* current = root.get();
+        while (current->right) {
+            current = current->right.get();
+        }
+        return current->data;
+    }
+
+    /**
+     * @brief Perform an inorder traversal of the snapshot
+     * @return A vector containing the keys in sorted order
+     */
+    std::vector<T> inorder_traversal() const {
+        std::vector<T> result;
+        result.reserve(size());
+
+        std::function<void(const PersistentAVLNode<T>*)> inorder = [&](const PersistentAVLNode<T>* node) {
+            if (node) {
+                inorder(node->left.get());
+                result.push_back(node->data);
+                inorder(node->right.get());
+            }
+        };
+
+        inorder(root.get());
+        return result;
+    }
+};
+
+/**
+ * @class PersistentAVLTree
+ * @brief Multi-version AVL tree: serialized writers, lock-free snapshot readers
+ */
+template<typename T>
+class PersistentAVLTree {
+private:
+    using Node = PersistentAVLNode<T>;
+    using NodePtr = typename Node::Ptr;
+
+    std::atomic<NodePtr> root;
+    std::atomic<uint64_t> current_version;
+    std::mutex writer;
+
+    static int get_height(const NodePtr& node) {
+        return node ? node->height : 0;
+    }
+
+    static NodePtr make(const T& data, NodePtr left, NodePtr right) {
+        return std::make_shared<const Node>(data, std::move(left), std::move(right));
+    }
+
+    // Build a node from data and two subtrees whose heights differ by at most 2,
+    // rotating (by building new nodes) if they differ by 2
+    static NodePtr balance(const T& data, NodePtr left, NodePtr right) {
+        int left_height = get_height(left);
+        int right_height = get_height(right);
+
+        if (left_height > right_height + 1) {
+            // Left Left Case
+            if (get_height(left->left) >= get_height(left->right)) {
+                return make(left->data, left->left, make(data, left->right, std::move(right)));
+            }
+            // Left Right Case
+            const NodePtr& middle = left->right;
+            return make(middle->data, make(left->data, left->left, middle->left),
+                        make(data, middle->right, std::move(right)));
+        }
+
+        if (right_height > left_height + 1) {
+            // Right Right Case
+            if (get_height(right->right) >= get_height(right->left)) {
+                return make(right->data, make(data, std::move(left), right->left), right->right);
+            }
+            // Right Left Case
+            const NodePtr& middle = right->left;
+            return make(middle->data, make(data, std::move(left), middle->left),
+                        make(right->data, middle->right, right->right));
+        }
+
+        return make(data, std::move(left), std::move(right));
+    }
+
+    static NodePtr insert_recursive(const NodePtr& node, const T& data) {
+        if (node == nullptr) {
+            return make(data, nullptr, nullptr);
+        }
+
+        if (data < node->data) {
+            return balance(node->data, insert_recursive(node->left, data), node->right);
+        }
+        return balance(node->data, node->left, insert_recursive(node->right, data));
+    }
+
+    static NodePtr remove_min(const NodePtr& node, T& min) {
+        if (node->left == nullptr) {
+            min = node->data;
+            return node->right;
+        }
+        return balance(node->data, remove_min(node->left, min), node->right);
+    }
+
+    // Returns the new subtree; leaves it untouched (same pointer) if data is absent
+    static NodePtr delete_recursive(const NodePtr& node, const T& data, bool& deleted) {
+        if (node == nullptr) {
+            return nullptr;
+        }
+
+        if (data < node->data) {
+            NodePtr left = delete_recursive(node->left, data, deleted);
+            return deleted ? balance(node->data, std::move(left), node->right) : node;
+        }
+        if (node->data < data) {
+            NodePtr right = delete_recursive(node->right, data, deleted);
+            return deleted ? balance(node->data, node->left, std::move(right)) : node;
+        }
+
+        deleted = true;
+        if (node->left == nullptr) {
+            return node->right;
+        }
+        if (node->right == nullptr) {
+            return node->left;
+        }
+
+        // Node with two children: replace it by its inorder successor
+        T successor = node->data;
+        NodePtr right = remove_min(node->right, successor);
+        return balance(successor, node->left, std::move(right));
+    }
+
+    void publish(NodePtr next) {
+        root.store(std::move(next), std::memory_order_release);
+        current_version.fetch_add(1, std::memory_order_release);
+    }
+
+public:
+    /**
+     * @brief Default constructor
+     */
+    PersistentAVLTree() : root(nullptr), current_version(0) {}
+
+    PersistentAVLTree(const PersistentAVLTree&) = delete;
+    PersistentAVLTree& operator=(const PersistentAVLTree&) = delete;
+
+    /**
+     * @brief Get an immutable view of the latest version in O(1); never blocks on writers
+     * @return The snapshot, which stays valid and unchanged while the tree is updated
+     */
+    PersistentAVLSnapshot<T> snapshot() const {
+        return PersistentAVLSnapshot<T>(root.load(std::memory_order_acquire));
+    }
+
+    /**
+     * @brief Get the number of updates published so far
+     */
+    uint64_t version() const {
+        return current_version.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Check if the latest version is empty
+     * @return true if the tree holds no keys, false otherwise
+     */
+    bool is_empty() const {
+        return snapshot().is_empty();
+    }
+
+    /**
+     * @brief Get the number of keys in the latest version
+     */
+    size_t size() const {
+        return snapshot().size();
+    }
+
+    /**
+     * @brief Search for a key in the latest version
+     * @param data The key to search for
+     * @return true if the key is present, false otherwise
+     */
+    bool search(const T& data) const {
+        return snapshot().search(data);
+    }
+
+    /**
+     * @brief Insert a key, publishing a new version
+     * @param data The key to be inserted
+     */
+    void insert(const T& data) {
+        std::lock_guard<std::mutex> lock(writer);
+        publish(insert_recursive(root.load(std::memory_order_relaxed), data));
+    }
+
+    /**
+     * @brief Delete one occurrence of a key, publishing a new version if it was present
+     * @param data The key to be deleted
+     * @return true if the key was deleted, false if it was not present
+     */
+    bool delete_node(const T& data) {
+        std::lock_guard<std::mutex> lock(writer);
+        bool deleted = false;
+        NodePtr next = delete_recursive(root.load(std::memory_order_relaxed), data, deleted);
+        if (deleted) {
+            publish(std::move(next));
+        }
+        return deleted;
+    }
+
+    /**
+     * @brief Remove all keys, publishing an empty version (live snapshots keep theirs)
+     */
+    void clear() {
+        std::lock_guard<std::mutex> lock(writer);
+        publish(nullptr);
+    }
+};
+
+#endif // PERSISTENT_AVL_TREE_HPP